@@ -18,6 +18,7 @@
 import org.openjdk.jmh.annotations.Scope;
 import org.openjdk.jmh.annotations.Setup;
 import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
 import org.openjdk.jmh.annotations.Threads;
 import org.openjdk.jmh.annotations.Warmup;
 import org.openjdk.jmh.infra.Blackhole;
@@ -44,6 +45,15 @@ private static class Args {
         private static final BigInteger[] BIG_INTEGER = parse(STRING, BigInteger::new, BigInteger.class);
         private static final Int9[] INT_9 = parse(STRING, Int9::fromString, Int9.class);
         private static final Int9N[] INT_9N = parse(STRING, Int9N::fromString, Int9N.class);
+
+        // short enough for the per-call overhead to matter
+        private static final String[] SMALL_STRING = {
+                "589034583485345", "58903457894375873489578943534",
+                "5".repeat(90), "6".repeat(100),
+                "8".repeat(400), "3".repeat(300),
+        };
+
+        private static final Int9N[] SMALL_INT_9N = parse(SMALL_STRING, Int9N::fromString, Int9N.class);
     }
 
 //    @Param({"10", "40", "80"})
@@ -94,6 +104,33 @@ public void multiplySimpleInt9N(Blackhole blackhole) {
         perform(Args.INT_9N, Int9N::multiplySimple, blackhole);
     }
 
+    // JNI vs. java.lang.foreign downcalls, switched outside of the measurement
+    @State(Scope.Benchmark)
+    public static class SmallCalls {
+
+        @Param({"false", "true"})
+        public boolean foreign;
+
+        @Setup
+        public void setup() {
+            Int9N.setForeignMultiply(foreign);
+        }
+
+        @TearDown
+        public void tearDown() {
+            Int9N.setForeignMultiply(false);
+        }
+    }
+
+    @Benchmark
+    @OutputTimeUnit(TimeUnit.NANOSECONDS)
+    public void multiplySmallInt9N(SmallCalls calls, Blackhole blackhole) {
+        if (!Int9N.nativeLibAvailable) {
+            throw new AssumptionViolatedException("Native library not available, skipping benchmark");
+        }
+        perform(Args.SMALL_INT_9N, Int9N::multiplySimple, blackhole);
+    }
+
     @Benchmark
     public void parseAndMultiplySimpleInt9(Blackhole blackhole) {
         parseAndPerform(Args.STRING, Int9::fromString, Int9::multiplySimple, blackhole);
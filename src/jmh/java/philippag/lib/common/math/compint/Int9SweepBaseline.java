@@ -0,0 +1,168 @@
+package philippag.lib.common.math.compint;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+import java.util.TreeMap;
+
+import org.openjdk.jmh.profile.GCProfiler;
+import org.openjdk.jmh.results.Result;
+import org.openjdk.jmh.results.RunResult;
+import org.openjdk.jmh.runner.Runner;
+import org.openjdk.jmh.runner.RunnerException;
+import org.openjdk.jmh.runner.options.OptionsBuilder;
+
+import philippag.lib.common.math.compint.Int9SweepBenchmark.Engine;
+
+/*
+ * Runs the feasible combinations of Int9SweepBenchmark with "-prof gc" and writes one line per result:
+ *
+ *   operation engine shape limbs score error unit alloc
+ *
+ * separated by tabs and sorted, alloc being the bytes allocated per operation ("gc.alloc.rate.norm").
+ * With "-compare old.tsv", results slower or allocating more than the old ones by more than the
+ * tolerance (and their error) are printed, and the exit status is 1 if there are any.
+ *
+ * Usage: Int9SweepBaseline [-o baseline.tsv] [-compare old.tsv] [-tolerance 0.1]
+ *                          [-maxLimbs 1000000] [-engines INT_9N,BIG_INTEGER] [-operations multiply,pow]
+ */
+public class Int9SweepBaseline {
+
+    private static final String HEADER = "# operation\tengine\tshape\tlimbs\tscore\terror\tunit\talloc";
+
+    public static void main(String[] args) throws IOException, RunnerException {
+        Path output = Path.of("build", "results", "jmh", "baseline.tsv");
+        Path compare = null;
+        double tolerance = 0.1;
+        int maxLimbs = Integer.MAX_VALUE;
+        List<String> engines = Arrays.stream(Engine.values()).map(Engine::name).toList();
+        List<String> operations = List.of(Int9SweepBenchmark.OPERATIONS);
+
+        for (int i = 0; i < args.length; i++) {
+            String value = i + 1 < args.length ? args[i + 1] : null;
+            switch (args[i]) {
+                case "-o" -> output = Path.of(value);
+                case "-compare" -> compare = Path.of(value);
+                case "-tolerance" -> tolerance = Double.parseDouble(value);
+                case "-maxLimbs" -> maxLimbs = Integer.parseInt(value);
+                case "-engines" -> engines = List.of(value.split(","));
+                case "-operations" -> operations = List.of(value.split(","));
+                default -> throw new IllegalArgumentException("Unknown option: " + args[i]);
+            }
+            i++;
+        }
+
+        var lines = new TreeMap<String, String>(); // key (first 4 columns) -> line
+        for (String operation : operations) {
+            boolean shaped = List.of(Int9SweepBenchmark.SHAPED_OPERATIONS).contains(operation);
+            for (String engineName : engines) {
+                Engine engine = Engine.valueOf(engineName);
+                int limit = Math.min(maxLimbs, engine.maxLimbs(operation));
+                String[] limbs = Arrays.stream(Int9SweepBenchmark.LIMBS).filter(n -> Integer.parseInt(n) <= limit).toArray(String[]::new);
+                if (limbs.length == 0) {
+                    continue;
+                }
+                var options = new OptionsBuilder()
+                        .include(Int9SweepBenchmark.class.getName() + "\\." + operation + "$")
+                        .param("engine", engine.name())
+                        .param("limbs", limbs)
+                        .param("shape", shaped ? new String[] { "balanced", "unbalanced" } : new String[] { "balanced" })
+                        .addProfiler(GCProfiler.class)
+                        .jvmArgsAppend("--enable-native-access=ALL-UNNAMED")
+                        .shouldFailOnError(true)
+                        .build();
+                for (RunResult result : new Runner(options).run()) {
+                    String line = line(operation, result);
+                    lines.put(key(line), line);
+                }
+            }
+        }
+
+        var content = new ArrayList<String>();
+        content.add(HEADER);
+        content.addAll(lines.values());
+        Path parent = output.toAbsolutePath().getParent();
+        if (parent != null) {
+            Files.createDirectories(parent);
+        }
+        Files.write(output, content);
+        System.out.println("Baseline written to " + output.toAbsolutePath());
+
+        if (compare != null && compare(read(compare), lines, tolerance) > 0) {
+            System.exit(1);
+        }
+    }
+
+    private static String line(String operation, RunResult result) {
+        var params = result.getParams();
+        Result<?> primary = result.getPrimaryResult();
+        double alloc = Double.NaN;
+        for (var entry : result.getSecondaryResults().entrySet()) {
+            if (entry.getKey().endsWith("gc.alloc.rate.norm")) {
+                alloc = entry.getValue().getScore();
+            }
+        }
+        return String.join("\t",
+                operation, params.getParam("engine"), params.getParam("shape"), params.getParam("limbs"),
+                format(primary.getScore()), format(primary.getScoreError()), primary.getScoreUnit(), format(alloc));
+    }
+
+    private static String format(double value) {
+        return String.format(Locale.ROOT, "%.3f", value);
+    }
+
+    private static String key(String line) {
+        String[] columns = line.split("\t");
+        return String.join("\t", Arrays.copyOf(columns, 4));
+    }
+
+    private static Map<String, String> read(Path baseline) throws IOException {
+        var lines = new TreeMap<String, String>();
+        for (String line : Files.readAllLines(baseline)) {
+            if (!line.isBlank() && !line.startsWith("#")) {
+                lines.put(key(line), line);
+            }
+        }
+        return lines;
+    }
+
+    // returns the number of regressions
+    private static int compare(Map<String, String> old, Map<String, String> current, double tolerance) {
+        int regressions = 0;
+        for (var entry : current.entrySet()) {
+            String oldLine = old.get(entry.getKey());
+            if (oldLine == null) {
+                continue; // new combination
+            }
+            String[] was = oldLine.split("\t");
+            String[] is = entry.getValue().split("\t");
+            if (!was[6].equals(is[6])) {
+                System.out.println("Unit changed, not compared: " + entry.getKey());
+                continue;
+            }
+            double wasScore = Double.parseDouble(was[4]);
+            double isScore = Double.parseDouble(is[4]);
+            double error = Double.parseDouble(is[5]);
+            if (Double.isNaN(error)) {
+                error = 0; // too few iterations
+            }
+            if (isScore - error > wasScore * (1 + tolerance)) {
+                System.out.printf(Locale.ROOT, "Slower: %s %s -> %s %s%n", entry.getKey(), was[4], is[4], is[6]);
+                regressions++;
+            }
+            double wasAlloc = Double.parseDouble(was[7]);
+            double isAlloc = Double.parseDouble(is[7]);
+            if (isAlloc > wasAlloc * (1 + tolerance) + 64) { // some bytes for Blackhole and boxing jitter
+                System.out.printf(Locale.ROOT, "Allocates more: %s %s -> %s bytes/op%n", entry.getKey(), was[7], is[7]);
+                regressions++;
+            }
+        }
+        System.out.println(regressions + " regressions against the old baseline (tolerance " + tolerance + ")");
+        return regressions;
+    }
+}
@@ -0,0 +1,221 @@
+package philippag.lib.common.math.compint;
+
+import java.math.BigInteger;
+import java.util.Random;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Threads;
+import org.openjdk.jmh.annotations.Warmup;
+
+/*
+ * The same operations for all implementations, over operand sizes from 1 to 1E6 limbs (of 9 digits).
+ * "balanced" operands have the same length, "unbalanced" ones differ by a factor of 16.
+ * Not all combinations finish in reasonable time (see Engine), so this is excluded from "gradle jmh":
+ * "gradle jmhSweep" runs the feasible ones with allocation profiling, see Int9SweepBaseline.
+ */
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@BenchmarkMode(Mode.AverageTime)
+@Measurement(iterations = 3, time = 1, timeUnit = TimeUnit.SECONDS)
+@Warmup(iterations = 3, time = 1, timeUnit = TimeUnit.SECONDS)
+@Threads(1)
+@Fork(1)
+@State(Scope.Benchmark)
+public class Int9SweepBenchmark {
+
+    static final String[] LIMBS = { "1", "10", "100", "1000", "10000", "100000", "1000000" };
+
+    static final String[] OPERATIONS = { "multiply", "square", "pow", "divide", "parse", "format" };
+
+    // operations whose operands depend on the shape
+    static final String[] SHAPED_OPERATIONS = { "multiply", "pow", "divide" };
+
+    // the largest operands (in limbs) each operation is run with, 0 if not supported
+    public enum Engine {
+        BIG_INTEGER(1_000_000, 1_000_000, 1_000_000, 100_000, 1_000_000) {
+            @Override
+            Object parse(String str) {
+                return new BigInteger(str);
+            }
+
+            @Override
+            Object operand(String str) {
+                return Int9N.fromString(str).toBigInteger(); // BigInteger(String) takes quadratic time
+            }
+
+            @Override
+            Object multiply(Object lhs, Object rhs) {
+                return ((BigInteger) lhs).multiply((BigInteger) rhs);
+            }
+
+            @Override
+            Object pow(Object base, int exponent) {
+                return ((BigInteger) base).pow(exponent);
+            }
+
+            @Override
+            Object divide(Object lhs, Object rhs) {
+                return ((BigInteger) lhs).divide((BigInteger) rhs);
+            }
+        },
+        INT_9(100_000, 100_000, 0, 1_000_000, 1_000_000) {
+            @Override
+            Object parse(String str) {
+                return Int9.fromString(str);
+            }
+
+            @Override
+            Object multiply(Object lhs, Object rhs) {
+                return ((Int9) lhs).multiply((Int9) rhs);
+            }
+
+            @Override
+            Object pow(Object base, int exponent) {
+                return ((Int9) base).pow(exponent);
+            }
+        },
+        INT_9N(1_000_000, 1_000_000, 1_000_000, 1_000_000, 1_000_000) {
+            @Override
+            Object parse(String str) {
+                return Int9N.fromString(str);
+            }
+
+            @Override
+            Object multiply(Object lhs, Object rhs) {
+                return ((Int9N) lhs).multiply((Int9N) rhs);
+            }
+
+            @Override
+            Object pow(Object base, int exponent) {
+                return ((Int9N) base).pow(exponent);
+            }
+
+            @Override
+            Object divide(Object lhs, Object rhs) {
+                return ((Int9N) lhs).divide((Int9N) rhs);
+            }
+        },
+        INT_ASCII(10_000, 0, 0, 1_000_000, 1_000_000) {
+            @Override
+            Object parse(String str) {
+                return IntAscii.fromString(str);
+            }
+
+            @Override
+            Object multiply(Object lhs, Object rhs) {
+                return ((IntAscii) lhs).multiply((IntAscii) rhs);
+            }
+        };
+
+        private final int multiplyMaxLimbs;
+        private final int powMaxLimbs;
+        private final int divideMaxLimbs;
+        private final int parseMaxLimbs;
+        private final int formatMaxLimbs;
+
+        Engine(int multiplyMaxLimbs, int powMaxLimbs, int divideMaxLimbs, int parseMaxLimbs, int formatMaxLimbs) {
+            this.multiplyMaxLimbs = multiplyMaxLimbs;
+            this.powMaxLimbs = powMaxLimbs;
+            this.divideMaxLimbs = divideMaxLimbs;
+            this.parseMaxLimbs = parseMaxLimbs;
+            this.formatMaxLimbs = formatMaxLimbs;
+        }
+
+        int maxLimbs(String operation) {
+            return switch (operation) {
+                case "multiply", "square" -> multiplyMaxLimbs;
+                case "pow" -> powMaxLimbs;
+                case "divide" -> divideMaxLimbs;
+                case "parse" -> parseMaxLimbs;
+                case "format" -> formatMaxLimbs;
+                default -> throw new IllegalArgumentException("Unknown operation: " + operation);
+            };
+        }
+
+        abstract Object parse(String str);
+
+        Object operand(String str) {
+            return parse(str);
+        }
+
+        abstract Object multiply(Object lhs, Object rhs);
+
+        Object pow(Object base, int exponent) {
+            throw new UnsupportedOperationException("pow() of " + this);
+        }
+
+        Object divide(Object lhs, Object rhs) {
+            throw new UnsupportedOperationException("divide() of " + this);
+        }
+    }
+
+    @Param({"BIG_INTEGER", "INT_9", "INT_9N", "INT_ASCII"})
+    public Engine engine;
+
+    @Param({"1", "10", "100", "1000", "10000", "100000", "1000000"})
+    public int limbs;
+
+    @Param({"balanced", "unbalanced"})
+    public String shape;
+
+    private String lhsString;
+    private Object lhs;
+    private Object rhs;
+    private Object dividend;
+    private Object powBase;
+    private int powExponent;
+
+    @Setup
+    public void setup() {
+        var rnd = new Random(limbs); // the same operands in every run
+        int rhsLimbs = "balanced".equals(shape) ? limbs : Math.max(1, limbs >> 4);
+        String rhsString = Calibration.randomDigits(rnd, rhsLimbs * 9);
+        lhsString = Calibration.randomDigits(rnd, limbs * 9);
+        lhs = engine.operand(lhsString);
+        rhs = engine.operand(rhsString);
+        dividend = engine.operand(lhsString + rhsString);
+        // the power has about as many limbs as lhs, from few large squares ("balanced") or many small ones
+        int powBaseLimbs = "balanced".equals(shape) ? Math.max(1, limbs >> 4) : 1;
+        powBase = engine.operand(Calibration.randomDigits(rnd, powBaseLimbs * 9));
+        powExponent = Math.max(1, limbs / powBaseLimbs);
+    }
+
+    @Benchmark
+    public Object multiply() {
+        return engine.multiply(lhs, rhs);
+    }
+
+    @Benchmark
+    public Object square() {
+        return engine.multiply(lhs, lhs);
+    }
+
+    @Benchmark
+    public Object pow() {
+        return engine.pow(powBase, powExponent);
+    }
+
+    @Benchmark
+    public Object divide() {
+        return engine.divide(dividend, rhs);
+    }
+
+    @Benchmark
+    public Object parse() {
+        return engine.parse(lhsString);
+    }
+
+    @Benchmark
+    public String format() {
+        return lhs.toString();
+    }
+}
@@ -27,6 +27,9 @@ of this software and associated documentation files (the "Software"), to deal
 import java.io.IOException;
 import java.io.OutputStream;
 import java.io.UncheckedIOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.SelectableChannel;
+import java.nio.channels.WritableByteChannel;
 
 /**
  * Provides "ASCII" digit streaming capabilites,
@@ -66,6 +69,71 @@ static AsciiDigitArraySink of(OutputStream out) {
                 return true;
             };
         }
+
+        // the channel must be blocking, as this doesn't wait for a non-blocking one to become writable
+        static AsciiDigitArraySink of(WritableByteChannel channel) {
+            if (channel instanceof SelectableChannel selectable && !selectable.isBlocking()) {
+                throw new IllegalArgumentException("Non-blocking channel");
+            }
+            return (array, offset, length) -> {
+                var buffer = ByteBuffer.wrap(array, offset, length);
+                try {
+                    while (buffer.hasRemaining()) {
+                        channel.write(buffer);
+                    }
+                } catch (IOException e) {
+                    throw new UncheckedIOException(e);
+                }
+                return true;
+            };
+        }
+    }
+
+    /**
+     * Collects the digits into chunks of a fixed size before passing them on,
+     * for sinks that have a cost per call, like channels or unbuffered streams.
+     * Arrays at least as long as a chunk are passed on as they are.
+     * The last chunk is passed on by flush().
+     */
+    public static final class ChunkedSink implements AsciiDigitArraySink {
+
+        private final AsciiDigitArraySink sink;
+        private final byte[] chunk;
+        private int length;
+
+        public ChunkedSink(AsciiDigitArraySink sink, int chunkLength) {
+            if (chunkLength < 1) {
+                throw new IllegalArgumentException("Illegal chunk length: " + chunkLength);
+            }
+            this.sink = sink;
+            this.chunk = new byte[chunkLength];
+        }
+
+        @Override
+        public boolean accept(byte[] array, int offset, int length) {
+            if (length >= chunk.length) {
+                return flush() && sink.accept(array, offset, length);
+            }
+            int n = Math.min(length, chunk.length - this.length);
+            System.arraycopy(array, offset, chunk, this.length, n);
+            this.length += n;
+            if (this.length < chunk.length) {
+                return true;
+            }
+            this.length = 0;
+            if (!sink.accept(chunk, 0, chunk.length)) {
+                return false;
+            }
+            System.arraycopy(array, offset + n, chunk, 0, length - n);
+            this.length = length - n;
+            return true;
+        }
+
+        public boolean flush() {
+            int n = length;
+            length = 0;
+            return n == 0 || sink.accept(chunk, 0, n);
+        }
     }
 
     public interface AsciiDigitStreamable {
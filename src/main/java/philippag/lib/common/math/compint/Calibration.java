@@ -0,0 +1,84 @@
+/*
+MIT License
+
+Copyright (c) 2024 Philipp Grasboeck
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+package philippag.lib.common.math.compint;
+
+import java.util.Random;
+import java.util.function.IntFunction;
+import java.util.function.Supplier;
+
+/*
+ * Times candidate thresholds against each other, for the calibrate methods of Int9, IntAscii and Int9N.Tuning.
+ */
+final class Calibration {
+
+    private static final int RUNS = 5; // timed, after as many warm-up runs
+    private static volatile Object sink; // keeps the measured results alive
+
+    private Calibration() {
+    }
+
+    // with a fixed seed, so that recalibrating measures the same operands
+    static Random random() {
+        return new Random(1_000_000_000);
+    }
+
+    // `length` random digits without leading zeroes
+    static String randomDigits(Random rnd, int length) {
+        var sb = new StringBuilder(length);
+        sb.append((char) ('1' + rnd.nextInt(9)));
+        while (sb.length() < length) {
+            sb.append((char) ('0' + rnd.nextInt(10)));
+        }
+        return sb.toString();
+    }
+
+    // the candidate with the shortest time(), the first one of equally fast ones
+    static int fastest(int[] candidates, IntFunction<?> fn) {
+        int best = candidates[0];
+        long bestTime = Long.MAX_VALUE;
+        for (int candidate : candidates) {
+            long time = time(() -> fn.apply(candidate));
+            if (time < bestTime) {
+                best = candidate;
+                bestTime = time;
+            }
+        }
+        return best;
+    }
+
+    // the best of RUNS, in nanoseconds
+    static long time(Supplier<?> fn) {
+        long best = Long.MAX_VALUE;
+        for (int i = 0; i < 2 * RUNS; i++) {
+            long start = System.nanoTime();
+            sink = fn.get();
+            long elapsed = System.nanoTime() - start;
+            if (i >= RUNS) {
+                best = Math.min(best, elapsed);
+            }
+        }
+        return best;
+    }
+}
@@ -35,6 +35,7 @@ of this software and associated documentation files (the "Software"), to deal
 import static philippag.lib.common.math.compint.Int9.Sealed.SHORT_MIN;
 import static philippag.lib.common.math.compint.Int9.Sealed.ZERO;
 
+import java.math.BigInteger;
 import java.util.Arrays;
 import java.util.Objects;
 import java.util.concurrent.ForkJoinPool;
@@ -72,6 +73,7 @@ public final class Int9 extends Number implements Comparable<Int9>, AsciiDigitSt
     private static final long BASE2 = BASE1 * BASE1;
     private static final int SIZE = 9;
     private static final int KARATSUBA_THRESHOLD = 40;
+    private static final int RADIX_CONVERSION_THRESHOLD = 32; // limbs or 32-bit words converted one by one
 
     private static final class Constants { // mutable!
 
@@ -503,6 +505,97 @@ private long toLongAbs() {
         }
     }
 
+    /*
+     * Conversions to and from binary are divide-and-conquer, so they run in O(M(n) log n):
+     * the low part takes the biggest power of two number of limbs (or 32-bit words) below n,
+     * and both parts are converted recursively and recombined with one multiplication
+     * by a cached (sealed) power of the other radix, see RadixPowers.
+     */
+    public BigInteger toBigInteger() {
+        var value = toBigIntegerAbs(0, length);
+        return isNegative() ? value.negate() : value;
+    }
+
+    // the limbs [from, to) as a non-negative BigInteger
+    private BigInteger toBigIntegerAbs(int from, int to) {
+        int n = to - from;
+        if (n <= RADIX_CONVERSION_THRESHOLD) {
+            var value = BigInteger.ZERO;
+            int i = from;
+            if (n % 2 != 0) {
+                value = BigInteger.valueOf(get(i++));
+            }
+            for (; i < to; i += 2) {
+                value = value.multiply(RadixPowers.BASE_SQUARED).add(BigInteger.valueOf(BASE1 * get(i) + get(i + 1)));
+            }
+            return value;
+        }
+        int k = Integer.highestOneBit(n - 1);
+        var high = toBigIntegerAbs(from, to - k);
+        var low = toBigIntegerAbs(to - k, to);
+        return high.multiply(RadixPowers.decimal(Integer.numberOfTrailingZeros(k))).add(low);
+    }
+
+    public static Int9 fromBigInteger(BigInteger value) {
+        return fromTwosComplement(value.toByteArray());
+    }
+
+    // the big-endian two's complement representation, like java.math.BigInteger.toByteArray()
+    public byte[] toTwosComplement() {
+        return toBigInteger().toByteArray();
+    }
+
+    // from a big-endian two's complement representation, like java.math.BigInteger(byte[])
+    public static Int9 fromTwosComplement(byte[] bytes) {
+        if (bytes.length == 0) {
+            throw new NumberFormatException("Zero length input array");
+        }
+        boolean negative = bytes[0] < 0;
+        int[] words = new int[(bytes.length + 3) / 4];
+        for (int i = bytes.length - 1, j = words.length - 1; j >= 0; --j) {
+            int word = 0;
+            for (int shift = 0; shift < 32; shift += 8, --i) {
+                int b = i >= 0 ? bytes[i] : negative ? -1 : 0;
+                word |= (b & 0xFF) << shift;
+            }
+            words[j] = word;
+        }
+        if (negative) {
+            // magnitude = ~value + 1
+            boolean carry = true;
+            for (int j = words.length - 1; j >= 0; --j) {
+                words[j] = ~words[j];
+                if (carry) {
+                    words[j]++;
+                    carry = words[j] == 0;
+                }
+            }
+        }
+        int from = 0;
+        while (from < words.length - 1 && words[from] == 0) {
+            from++;
+        }
+        var result = fromWords(words, from, words.length);
+        return result.isZero() ? result : result.setNegative0(negative);
+    }
+
+    // the unsigned big-endian 32-bit words [from, to)
+    private static Int9 fromWords(int[] words, int from, int to) {
+        int n = to - from;
+        if (n <= RADIX_CONVERSION_THRESHOLD) {
+            var value = Constants.ZERO();
+            for (int i = from; i < to; i++) {
+                value.multiplyInPlace(1 << 16).addInPlace(words[i] >>> 16);
+                value.multiplyInPlace(1 << 16).addInPlace(words[i] & 0xFFFF);
+            }
+            return value;
+        }
+        int k = Integer.highestOneBit(n - 1);
+        var high = fromWords(words, from, to - k);
+        var low = fromWords(words, to - k, to);
+        return high.multiply(RadixPowers.binary(Integer.numberOfTrailingZeros(k))).addInPlace(low);
+    }
+
     public int compareTo(long o) {
         int cmp = -Boolean.compare(isNegative(), o < 0);
         return cmp != 0 ? cmp : isNegative() ? -compareToAbs(o) : compareToAbs(o);
@@ -1228,6 +1321,31 @@ public static void setForkJoinPool(ForkJoinPool pool) {
         forkJoinPool = pool;
     }
 
+    private static int karatsubaThreshold = KARATSUBA_THRESHOLD;
+
+    // the threshold of all methods without an explicit one, e.g. the one from calibrateKaratsubaThreshold()
+    public static void setKaratsubaThreshold(int threshold) {
+        if (threshold < 1) {
+            throw new IllegalArgumentException("Illegal threshold: " + threshold);
+        }
+        karatsubaThreshold = threshold;
+    }
+
+    public static int getKaratsubaThreshold() {
+        return karatsubaThreshold;
+    }
+
+    /*
+     * Times multiplyKaratsuba() with a few thresholds on random operands of 5760 digits (after a warm-up)
+     * and returns the fastest one, for setKaratsubaThreshold(). Takes a fraction of a second.
+     */
+    public static int calibrateKaratsubaThreshold() {
+        var rnd = Calibration.random();
+        var lhs = fromString(Calibration.randomDigits(rnd, 9 * 640));
+        var rhs = fromString(Calibration.randomDigits(rnd, 9 * 640));
+        return Calibration.fastest(new int[] { 10, 20, 40, 80, 160 }, threshold -> multiplyKaratsuba(lhs, rhs, threshold));
+    }
+
     /* ============================
      * static functional arithmetic
      * ============================
@@ -1589,7 +1707,7 @@ public boolean isEven() {
     }
 
     public static Int9 pow(Int9 base, int exponent) {
-        return pow(base, exponent, KARATSUBA_THRESHOLD);
+        return pow(base, exponent, karatsubaThreshold);
     }
 
     public static Int9 pow(Int9 base, int exponent, int threshold) {
@@ -1609,7 +1727,7 @@ public static Int9 pow(Int9 base, int exponent, int threshold) {
     }
 
     public static Int9 parallelPow(Int9 base, int exponent, ForkJoinPool pool) {
-        return parallelPow(base, exponent, KARATSUBA_THRESHOLD, Calc.maxDepth(pool), pool);
+        return parallelPow(base, exponent, karatsubaThreshold, Calc.maxDepth(pool), pool);
     }
 
     public static Int9 parallelPow(Int9 base, int exponent, int threshold, int maxDepth, ForkJoinPool pool) {
@@ -1648,7 +1766,7 @@ Int9 rightPart(int n) {
     }
 
     public static Int9 multiplyKaratsuba(Int9 lhs, Int9 rhs) {
-        return multiplyKaratsuba(lhs, rhs, KARATSUBA_THRESHOLD);
+        return multiplyKaratsuba(lhs, rhs, karatsubaThreshold);
     }
 
     public static Int9 multiplyKaratsuba(Int9 lhs, Int9 rhs, int threshold) {
@@ -1707,7 +1825,7 @@ private static Int9 multiplyKaratsubaImpl(Int9 lhs, Int9 rhs, int threshold) {
     }
 
     public static Int9 parallelMultiplyKaratsuba(Int9 lhs, Int9 rhs, ForkJoinPool pool) {
-        return parallelMultiplyKaratsuba(lhs, rhs, KARATSUBA_THRESHOLD, Calc.maxDepth(pool), pool);
+        return parallelMultiplyKaratsuba(lhs, rhs, karatsubaThreshold, Calc.maxDepth(pool), pool);
     }
 
     public static Int9 parallelMultiplyKaratsuba(Int9 lhs, Int9 rhs, int threshold, int maxDepth, ForkJoinPool pool) {
@@ -1824,6 +1942,35 @@ public Int9 subSequence(int start, int end) {
         return fromString(this, start, end);
     }
 
+    /*
+     * binary(i) = 2^(32 * 2^i) and decimal(i) = BASE^(2^i), each squared from the previous one on first use.
+     */
+    private static final class RadixPowers {
+
+        static final BigInteger BASE_SQUARED = BigInteger.valueOf(BASE2);
+
+        private static Int9[] binary = { fromLong(1L << 32).seal() };
+        private static BigInteger[] decimal = { BigInteger.valueOf(BASE) };
+
+        static synchronized Int9 binary(int i) {
+            while (binary.length <= i) {
+                var last = binary[binary.length - 1];
+                binary = Arrays.copyOf(binary, binary.length + 1);
+                binary[binary.length - 1] = last.multiply(last).seal();
+            }
+            return binary[i];
+        }
+
+        static synchronized BigInteger decimal(int i) {
+            while (decimal.length <= i) {
+                var last = decimal[decimal.length - 1];
+                decimal = Arrays.copyOf(decimal, decimal.length + 1);
+                decimal[decimal.length - 1] = last.multiply(last);
+            }
+            return decimal[i];
+        }
+    }
+
     private static class Calc {
 
         static int maxDepth(ForkJoinPool pool) {
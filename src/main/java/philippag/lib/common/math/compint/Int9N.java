@@ -26,13 +26,44 @@ of this software and associated documentation files (the "Software"), to deal
 
 import java.io.File;
 import java.io.IOException;
+import java.io.UncheckedIOException;
+import java.lang.foreign.FunctionDescriptor;
+import java.lang.foreign.Linker;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.SymbolLookup;
+import java.lang.foreign.ValueLayout;
+import java.lang.invoke.MethodHandle;
+import java.lang.management.ManagementFactory;
+import java.lang.ref.WeakReference;
+import java.math.BigInteger;
+import java.nio.BufferOverflowException;
+import java.nio.BufferUnderflowException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.SelectableChannel;
+import java.nio.channels.WritableByteChannel;
+import java.nio.charset.StandardCharsets;
 import java.nio.file.Files;
+import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.HashSet;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
 import java.util.Objects;
+import java.util.Properties;
+import java.util.Random;
+import java.util.Set;
 import java.util.concurrent.ForkJoinPool;
 import java.util.concurrent.ForkJoinTask;
 import java.util.concurrent.RecursiveTask;
+import java.util.function.BinaryOperator;
 import java.util.function.Supplier;
+import java.util.stream.Collector;
+
+import javax.management.InstanceAlreadyExistsException;
+import javax.management.JMException;
+import javax.management.ObjectName;
 
 import philippag.lib.common.math.compint.AsciiDigits.AsciiDigitArraySink;
 import philippag.lib.common.math.compint.AsciiDigits.AsciiDigitStreamable;
@@ -55,13 +86,33 @@ of this software and associated documentation files (the "Software"), to deal
  * but instead offers random access to decimal digits.
  *
  * This class implements some core/hot routines natively:
- * - multiplyCore() - a slight speedup can be observed, esp. single-threaded
+ * - multiplyCore() - sums up to 16 rows of products before carrying,
+ *   with AVX2 and AVX-512 variants chosen when the library is loaded
+ * - multiplyColumnsCore() - the same, column by column, for short operands
+ * - squareCore() - computes each cross product once; all multiplications
+ *   detect squares (lhs and rhs being the same limbs), e.g. in pow()
+ * - multiplySubquadraticCore() - the whole Karatsuba and Toom-Cook-3 recursion,
+ *   so there is only one JNI transition per multiplication instead of one per leaf
+ * - multiplyNttCore() - number-theoretic transform modulo three primes, for huge numbers
+ * - multiplySubquadraticDirectCore(), multiplyNttDirectCore() - the same on a direct buffer,
+ *   so GC is not blocked while they run, see setOffHeapMultiply()
+ * - divideCore() - Knuth's Algorithm D, for dividing by multi-limb numbers
+ * - divideIntCore(), moduloIntsCore() - division by an int, through a precomputed reciprocal
+ * - shiftDigitsCore() - the sub-limb part of shiftDecimalLeft() and shiftDecimalRight()
+ * - modMultiplyCore(), modPowCore() - Montgomery multiplication and exponentiation, see ModContext
+ * - addCore(), subtractCore() - in-place addition and subtraction of long operands,
+ *   which resolve the carries of 64 limbs at once on AVX2
+ * - multiplyAddCore() - long multiplication adding into an accumulator, see multiplyAddInPlace()
+ * - multiplyParallelDirectCore() - one product on several native threads, see parallelMultiplyNative()
+ * - parseCore(), formatCore() - ASCII digits to limbs and back, 2 (resp. 4) limbs per step on AVX2
+ * - parseDirectCore(), formatDirectCore() - the same on a direct buffer, e.g. a mapped file
+ * - the first three are also bound via java.lang.foreign, see setForeignMultiply()
  * - experiments with implemeneting charAt() natively showed huge slow down
  *   probably due to JNI/Java context switching overhead
  */
 public final class Int9N implements Comparable<Int9N>, AsciiDigitStreamable, CharSequence {
 
-    public static final boolean nativeLibAvailable = NativeLibLoader.loadAsResource(Int9N.class, "int9.so", /*autoExtract*/ true);
+    public static final boolean nativeLibAvailable = NativeLibLoader.loadBestVariant(Int9N.class, "int9", /*autoExtract*/ true);
 
     private static final int BASE = 1_000_000_000;
     private static final int HALF_BASE = BASE / 2;
@@ -70,6 +121,24 @@ public final class Int9N implements Comparable<Int9N>, AsciiDigitStreamable, Cha
     private static final long BASE2 = BASE1 * BASE1;
     private static final int SIZE = 9;
     private static final int KARATSUBA_THRESHOLD = 40;
+    private static final int TOOM_COOK_3_THRESHOLD = 240; // same as java.math.BigInteger's
+    private static final int NTT_THRESHOLD = 320;
+    private static final int COLUMNS_MULTIPLY_MAX_LENGTH = 400;
+    private static final int NEWTON_DIVISION_THRESHOLD = 1000;
+    private static final int PARALLEL_THRESHOLD = 500; // below, a sequential multiplication takes too short for a task of its own
+    private static final int NATIVE_ADD_MIN_LENGTH = 64; // below, the JNI transition costs more than the native loop saves
+    private static final int NATIVE_ASCII_MIN_LENGTH = 32; // limbs, below, parsing and formatting stay in Java
+    private static final int STREAM_CHUNK_LENGTH = 256; // limbs formatted at once by stream()
+    private static final int CHANNEL_CHUNK_LENGTH = 8192; // limbs formatted at once by write()
+    private static final ThreadLocal<ByteBuffer> CHANNEL_BUFFERS = ThreadLocal.withInitial(
+            () -> ByteBuffer.allocateDirect(1 + SIZE + SIZE * CHANNEL_CHUNK_LENGTH)); // reused, direct memory is freed only by GC
+    private static final int RADIX_CONVERSION_THRESHOLD = 32; // limbs or 32-bit words converted one by one
+    private static final String CALIBRATE_PROPERTY = "philippag.compint.calibrate";
+    private static final String STATS_PROPERTY = "philippag.compint.stats";
+    private static final String TUNING_FILE = "int9.tuning"; // next to the native library, see Tuning.calibrated()
+    private static final int MAX_WINDOW_BITS = 8; // for pow() and ModContext.modPow(), 128 odd powers of the base
+    private static final int BINARY_VERSION = 1;
+    private static final int BINARY_HEADER_LENGTH = 10; // version, flags, length, trailing zero limbs
 
     // never return to user!
     private static final Int9N ZERO     = Constants.ZERO();
@@ -93,6 +162,7 @@ private static class Constants {
     private int[] data; // integers from 000_000_000 to 999_999_999
     private int offset;
     private int length;
+    private long firstDigits = -1; // (leading limb << 4) | its number of digits, see firstDigitLength()
 
     //@VisibleForTesting
     Int9N(int... data) {
@@ -147,9 +217,11 @@ public boolean stream(AsciiDigitArraySink sink) {
             return false;
         }
 
-        for (int i = 1; i < length; i++) {
-            IntegerFormat.format(dest, get(i), 0, SIZE);
-            if (!sink.accept(dest, 0, SIZE)) {
+        byte[] chunk = new byte[SIZE * Math.min(length - 1, STREAM_CHUNK_LENGTH)];
+        for (int i = 1; i < length; i += STREAM_CHUNK_LENGTH) {
+            int to = Math.min(length, i + STREAM_CHUNK_LENGTH);
+            formatLimbs(chunk, 0, i, to);
+            if (!sink.accept(chunk, 0, SIZE * (to - i))) {
                 return false;
             }
         }
@@ -159,13 +231,10 @@ public boolean stream(AsciiDigitArraySink sink) {
     public byte[] toByteArray(boolean includeSign) {
         boolean emitNegativeSign = includeSign && negative;
         byte[] dest = new byte[emitNegativeSign ? 1 + countDigits() : countDigits()];
-        int right = dest.length;
+        int right = dest.length - SIZE * (length - 1);
 
-        for (int i = length - 1; i >= 0; --i) {
-            int left = Math.max(0, right - SIZE);
-            IntegerFormat.format(dest, get(i), left, right);
-            right = left;
-        }
+        formatLimbs(dest, right, 1, length);
+        IntegerFormat.format(dest, get(0), Math.max(0, right - SIZE), right);
         if (emitNegativeSign) {
             dest[0] = '-';
         }
@@ -173,6 +242,161 @@ public byte[] toByteArray(boolean includeSign) {
         return dest;
     }
 
+    // the limbs [from, to) with SIZE digits each, to dest[destOffset..]
+    private void formatLimbs(byte[] dest, int destOffset, int from, int to) {
+        int end = Math.max(from, Math.min(offset + to, data.length) - offset); // "trailingZeroesForm" from here
+        if (end - from >= NATIVE_ASCII_MIN_LENGTH) {
+            formatCore(data, offset + from, offset + end, dest, destOffset);
+        } else {
+            for (int i = from, left = destOffset; i < end; i++, left += SIZE) {
+                IntegerFormat.format(dest, data[offset + i], left, left + SIZE);
+            }
+        }
+        Arrays.fill(dest, destOffset + SIZE * (end - from), destOffset + SIZE * (to - from), (byte) '0');
+    }
+
+    private static native void formatCore(int[] data, int from, int to, byte[] dest, int destOffset);
+
+    /*
+     * Copies the digits [from, from + len) of toString(), not counting the sign, to dst[off..].
+     * Whole limbs are formatted in bulk (natively, for long ranges) instead of one digit at a time like charAt().
+     */
+    public void getDigits(int from, byte[] dst, int off, int len) {
+        Objects.checkFromIndexSize(from, len, countDigits());
+        Objects.checkFromIndexSize(off, len, dst.length);
+        if (len == 0) {
+            return;
+        }
+        int start = from + SIZE - firstDigitLength(); // as if the first limb had SIZE digits, too
+        int first = DivMulTable.div9(start);
+        int last = DivMulTable.div9(start + len - 1);
+        int skip = DivMulTable.mod9(first, start);
+        byte[] digits = new byte[SIZE];
+
+        formatLimbs(digits, 0, first, first + 1);
+        if (first == last) {
+            System.arraycopy(digits, skip, dst, off, len);
+            return;
+        }
+        System.arraycopy(digits, skip, dst, off, SIZE - skip);
+        int pos = off + SIZE - skip;
+        formatLimbs(dst, pos, first + 1, last);
+        pos += SIZE * (last - first - 1);
+        formatLimbs(digits, 0, last, last + 1);
+        System.arraycopy(digits, 0, dst, pos, off + len - pos);
+    }
+
+    /*
+     * Writes the same as toString() to the channel and returns the number of bytes written.
+     * The native code formats the digits into a direct buffer, in chunks of CHANNEL_CHUNK_LENGTH limbs,
+     * from which channels like FileChannel write without another copy. The buffer is kept per thread.
+     * The channel must be blocking, as this doesn't wait for a non-blocking one to become writable.
+     */
+    public long write(WritableByteChannel channel) throws IOException {
+        if (channel instanceof SelectableChannel selectable && !selectable.isBlocking()) {
+            throw new IllegalArgumentException("Non-blocking channel");
+        }
+        int capacity = 1 + SIZE + SIZE * Math.min(length - 1, CHANNEL_CHUNK_LENGTH);
+        var buffer = CHANNEL_BUFFERS.get().clear().limit(capacity);
+        if (negative) {
+            buffer.put((byte) '-');
+        }
+        byte[] first = new byte[SIZE];
+        int m = SIZE - firstDigitLength();
+        IntegerFormat.format(first, get(0), 0, SIZE);
+        buffer.put(first, m, SIZE - m);
+
+        long written = 0;
+        int i = 1;
+        do {
+            int to = Math.min(length, i + buffer.remaining() / SIZE);
+            formatLimbs(buffer, i, to);
+            i = to;
+            buffer.flip();
+            while (buffer.hasRemaining()) {
+                written += channel.write(buffer);
+            }
+            buffer.clear().limit(capacity);
+        } while (i < length);
+        return written;
+    }
+
+    // like formatLimbs(byte[], int, int, int), at the buffer's position, which is advanced
+    private void formatLimbs(ByteBuffer dest, int from, int to) {
+        int end = Math.max(from, Math.min(offset + to, data.length) - offset);
+        int position = dest.position();
+        formatDirectCore(data, offset + from, offset + end, dest, position);
+        for (int i = position + SIZE * (end - from); i < position + SIZE * (to - from); i++) {
+            dest.put(i, (byte) '0');
+        }
+        dest.position(position + SIZE * (to - from));
+    }
+
+    private static native void formatDirectCore(int[] data, int from, int to, ByteBuffer dest, int destOffset);
+
+    /*
+     * Binary format (version 1), all little-endian:
+     * byte version, byte flags (1 = negative), int length (limbs), int trailing zero limbs,
+     * then the (length - trailing zero limbs) stored limbs as int32, most significant first.
+     * The trailing zero limbs are not written, and readFrom() restores them in the same implicit form.
+     */
+    public int binaryLength() {
+        return BINARY_HEADER_LENGTH + Integer.BYTES * (extent() - offset);
+    }
+
+    /*
+     * Writes the binary format at the buffer's position, which is advanced.
+     * Throws BufferOverflowException, without writing anything, if less than binaryLength() bytes remain.
+     */
+    public void writeTo(ByteBuffer buffer) {
+        int binaryLength = binaryLength();
+        if (buffer.remaining() < binaryLength) {
+            throw new BufferOverflowException();
+        }
+        int stored = extent() - offset;
+        var out = buffer.slice().order(ByteOrder.LITTLE_ENDIAN);
+        out.put((byte) BINARY_VERSION).put((byte) (negative ? 1 : 0)).putInt(length).putInt(length - stored);
+        out.asIntBuffer().put(data, offset, stored);
+        buffer.position(buffer.position() + binaryLength);
+    }
+
+    /*
+     * Reads the binary format written by writeTo() at the buffer's position, which is advanced.
+     * The limbs are copied in bulk, then only range-checked.
+     */
+    public static Int9N readFrom(ByteBuffer buffer) {
+        var in = buffer.slice().order(ByteOrder.LITTLE_ENDIAN);
+        if (in.remaining() < BINARY_HEADER_LENGTH) {
+            throw new BufferUnderflowException();
+        }
+        int version = in.get();
+        if (version != BINARY_VERSION) {
+            throw new NumberFormatException("Unsupported binary format version: " + version);
+        }
+        int flags = in.get();
+        int length = in.getInt();
+        int trailingZeroes = in.getInt();
+        if ((flags & ~1) != 0 || length < 1 || trailingZeroes < 0 || trailingZeroes >= length) {
+            throw new NumberFormatException("Malformed binary header");
+        }
+        int stored = length - trailingZeroes;
+        if (in.remaining() / Integer.BYTES < stored) {
+            throw new BufferUnderflowException();
+        }
+        int[] data = new int[stored];
+        in.asIntBuffer().get(data);
+        for (int value : data) {
+            if (Integer.compareUnsigned(value, BASE) >= 0) {
+                throw new NumberFormatException("Limb out of range: " + Integer.toUnsignedString(value));
+            }
+        }
+        if (data[0] == 0 && length > 1) {
+            throw new NumberFormatException("Leading zero limb");
+        }
+        buffer.position(buffer.position() + BINARY_HEADER_LENGTH + Integer.BYTES * stored);
+        return new Int9N(data, 0, length).setNegative((flags & 1) != 0);
+    }
+
     @Override
     @SuppressWarnings("deprecation")
     public String toString() {
@@ -281,8 +505,16 @@ private boolean canonicalized() {
         return true;
     }
 
+    // cached for charAt() and friends, valid as long as the leading limb stays the same, so none of the
+    // methods mutating this number has to reset it; limb and count are written together, as one long
     private int firstDigitLength() {
-        return IntegerFormat.length(data[offset]);
+        int first = data[offset];
+        long cached = firstDigits;
+        if (cached >> 4 != first) {
+            cached = (long) first << 4 | IntegerFormat.length(first);
+            firstDigits = cached;
+        }
+        return (int) cached & 0xF;
     }
 
     /* ===============
@@ -371,6 +603,15 @@ public static Int9N fromString(CharSequence str, int fromIndex, int toIndex) {
             throw new NumberFormatException("No digits in input string");
         }
         int length = Calc.lengthForDigits(digits);
+        if (length >= NATIVE_ASCII_MIN_LENGTH && (str instanceof Latin1Chars || str instanceof String)) {
+            // non-Latin-1 characters become '?', and for any non-digit the loop below throws the exception
+            var value = str instanceof Latin1Chars latin1
+                    ? parseNative(latin1.bytes, fromIndex, toIndex, length, negative)
+                    : parseNative(ByteBuffer.wrap(str.subSequence(fromIndex, toIndex).toString().getBytes(StandardCharsets.ISO_8859_1)), 0, digits, length, negative);
+            if (value != null) {
+                return value;
+            }
+        }
         int[] result = null;
 
         for (int i = toIndex, j = length - 1; j >= 0; --j) {
@@ -388,6 +629,59 @@ public static Int9N fromString(CharSequence str, int fromIndex, int toIndex) {
         return result == null ? Constants.ZERO() : new Int9N(result, 0, length).setNegative(negative);
     }
 
+    // from Latin-1 (or ASCII) digits, e.g. read from a file, like fromString(CharSequence, int, int)
+    public static Int9N fromString(byte[] ascii, int fromIndex, int toIndex) {
+        return fromString(ByteBuffer.wrap(ascii), fromIndex, toIndex);
+    }
+
+    /*
+     * From the bytes [fromIndex, toIndex) of the buffer (absolute indexes, the position doesn't matter).
+     * Direct buffers, e.g. a MappedByteBuffer of a file, are parsed by the native code in place,
+     * so only the limbs are allocated, which take less than half the memory of the digits.
+     */
+    public static Int9N fromString(ByteBuffer buffer, int fromIndex, int toIndex) {
+        Objects.checkFromToIndex(fromIndex, toIndex, buffer.limit());
+        return fromString(new Latin1Chars(buffer), fromIndex, toIndex);
+    }
+
+    // like fromString(ByteBuffer, int, int), the segment must be shorter than 2 GB, see MemorySegment.asByteBuffer()
+    public static Int9N fromString(MemorySegment segment) {
+        var buffer = segment.asByteBuffer();
+        return fromString(buffer, 0, buffer.limit());
+    }
+
+    /*
+     * Parses `length` limbs natively, see parseCore() in int9.c, the first one of which is not zero.
+     * Returns null if there's a non-digit, or if the buffer is neither direct nor backed by an accessible array.
+     */
+    private static Int9N parseNative(ByteBuffer ascii, int fromIndex, int toIndex, int length, boolean negative) {
+        int[] result = new int[length];
+        if (ascii.isDirect()) {
+            if (!parseDirectCore(ascii, fromIndex, toIndex, result)) {
+                return null;
+            }
+        } else if (ascii.hasArray()) {
+            int arrayOffset = ascii.arrayOffset();
+            if (!parseCore(ascii.array(), arrayOffset + fromIndex, arrayOffset + toIndex, result)) {
+                return null;
+            }
+        } else {
+            return null;
+        }
+        int last = length - 1;
+        while (result[last] == 0) {
+            last--;
+        }
+        if (last < length - 1) {
+            result = Arrays.copyOf(result, last + 1); // "trailingZeroesForm", like in fromString()
+        }
+        return new Int9N(result, 0, length).setNegative(negative);
+    }
+
+    private static native boolean parseCore(byte[] ascii, int fromIndex, int toIndex, int[] result);
+
+    private static native boolean parseDirectCore(ByteBuffer ascii, int fromIndex, int toIndex, int[] result);
+
     public boolean isInt() {
         return compareToAbs(negative ? INT_MIN : INT_MAX) <= 0;
     }
@@ -432,6 +726,97 @@ private long toLongAbs() {
         }
     }
 
+    /*
+     * Conversions to and from binary are divide-and-conquer, so they run in O(M(n) log n):
+     * the low part takes the biggest power of two number of limbs (or 32-bit words) below n,
+     * and both parts are converted recursively and recombined with one multiplication
+     * by a cached power of the other radix, see RadixPowers.
+     */
+    public BigInteger toBigInteger() {
+        var value = toBigIntegerAbs(0, length);
+        return negative ? value.negate() : value;
+    }
+
+    // the limbs [from, to) as a non-negative BigInteger
+    private BigInteger toBigIntegerAbs(int from, int to) {
+        int n = to - from;
+        if (n <= RADIX_CONVERSION_THRESHOLD) {
+            var value = BigInteger.ZERO;
+            int i = from;
+            if (n % 2 != 0) {
+                value = BigInteger.valueOf(get(i++));
+            }
+            for (; i < to; i += 2) {
+                value = value.multiply(RadixPowers.BASE_SQUARED).add(BigInteger.valueOf(BASE1 * get(i) + get(i + 1)));
+            }
+            return value;
+        }
+        int k = Integer.highestOneBit(n - 1);
+        var high = toBigIntegerAbs(from, to - k);
+        var low = toBigIntegerAbs(to - k, to);
+        return high.multiply(RadixPowers.decimal(Integer.numberOfTrailingZeros(k))).add(low);
+    }
+
+    public static Int9N fromBigInteger(BigInteger value) {
+        return fromTwosComplement(value.toByteArray());
+    }
+
+    // the big-endian two's complement representation, like java.math.BigInteger.toByteArray()
+    public byte[] toTwosComplement() {
+        return toBigInteger().toByteArray();
+    }
+
+    // from a big-endian two's complement representation, like java.math.BigInteger(byte[])
+    public static Int9N fromTwosComplement(byte[] bytes) {
+        if (bytes.length == 0) {
+            throw new NumberFormatException("Zero length input array");
+        }
+        boolean negative = bytes[0] < 0;
+        int[] words = new int[(bytes.length + 3) / 4];
+        for (int i = bytes.length - 1, j = words.length - 1; j >= 0; --j) {
+            int word = 0;
+            for (int shift = 0; shift < 32; shift += 8, --i) {
+                int b = i >= 0 ? bytes[i] : negative ? -1 : 0;
+                word |= (b & 0xFF) << shift;
+            }
+            words[j] = word;
+        }
+        if (negative) {
+            // magnitude = ~value + 1
+            boolean carry = true;
+            for (int j = words.length - 1; j >= 0; --j) {
+                words[j] = ~words[j];
+                if (carry) {
+                    words[j]++;
+                    carry = words[j] == 0;
+                }
+            }
+        }
+        int from = 0;
+        while (from < words.length - 1 && words[from] == 0) {
+            from++;
+        }
+        var result = fromWords(words, from, words.length);
+        return result.isZero() ? result : result.setNegative(negative);
+    }
+
+    // the unsigned big-endian 32-bit words [from, to)
+    private static Int9N fromWords(int[] words, int from, int to) {
+        int n = to - from;
+        if (n <= RADIX_CONVERSION_THRESHOLD) {
+            var value = Constants.ZERO();
+            for (int i = from; i < to; i++) {
+                value.multiplyInPlace(1 << 16).addInPlace(words[i] >>> 16);
+                value.multiplyInPlace(1 << 16).addInPlace(words[i] & 0xFFFF);
+            }
+            return value;
+        }
+        int k = Integer.highestOneBit(n - 1);
+        var high = fromWords(words, from, to - k);
+        var low = fromWords(words, to - k, to);
+        return high.multiply(RadixPowers.binary(Integer.numberOfTrailingZeros(k))).addInPlace(low);
+    }
+
     public int compareTo(long o) {
         int cmp = -Boolean.compare(negative, o < 0);
         return cmp != 0 ? cmp : negative ? -compareToAbs(o) : compareToAbs(o);
@@ -545,7 +930,7 @@ public void setValue(long rhs) {
     private int[] copyFullSizeArray() {
         // undo "trailingZeroesForm" storage optimization
         int[] newData = new int[length];
-        System.arraycopy(data, offset, newData, 0, Math.min(length, data.length));
+        System.arraycopy(data, offset, newData, 0, extent() - offset);
         return newData;
     }
 
@@ -562,7 +947,7 @@ private Int9N copyFullSize() {
     private Int9N copyDoubleSize() {
         int newOffset = length << 1;
         int[] newData = new int[newOffset + length];
-        System.arraycopy(data, offset, newData, newOffset, Math.min(length, data.length));
+        System.arraycopy(data, offset, newData, newOffset, extent() - offset);
         return new Int9N(newData, newOffset, length).setNegative(negative);
     }
 
@@ -571,6 +956,7 @@ private void ensureCapacity(int minOffset) {
         // though both resizes happening is not very likely
         if (trailingZeroesForm()) {
             data = copyFullSizeArray();
+            offset = 0;
         }
         if (offset < minOffset) {
             resize(minOffset);
@@ -694,6 +1080,83 @@ private void multiplyInPlaceAbs(int rhs) {
         }
     }
 
+    /*
+     * this += lhs * rhs, adding the products straight into our limbs, without an interim array.
+     * That stays the case as long as long multiplication would be used for the product, and its
+     * sign is the same as ours: otherwise the product is computed separately and added up.
+     */
+    public Int9N multiplyAddInPlace(Int9N lhs, Int9N rhs) {
+        if (lhs.isZero() || rhs.isZero()) {
+            return this;
+        }
+        boolean productNegative = multiplySign(lhs.negative, rhs.negative);
+        if ((!isZero() && negative != productNegative) || lhs == this || rhs == this
+                || (lhs.length > tuning().karatsubaThreshold && rhs.length > tuning().karatsubaThreshold)) {
+            return addInPlace(lhs.multiply(rhs));
+        }
+
+        expandForMultiplyAdd(lhs.length + rhs.length);
+        int lhsSize = lhs.extent();
+        int rhsSize = rhs.extent();
+        int shift = 1 + (lhs.offset + lhs.length - lhsSize) + (rhs.offset + rhs.length - rhsSize); // "trailingZeroesForm"
+        int carry = multiplyAddCore(data, offset, offset + length, shift,
+                lhs.data, lhs.offset, lhsSize - 1,
+                rhs.data, rhs.offset, rhsSize - 1);
+        if (carry > 0) {
+            expandWith(carry);
+        }
+        canonicalize();
+        return setNegative(productNegative);
+    }
+
+    // this += lhs * rhs, in the same manner
+    public Int9N multiplyAddInPlace(Int9N lhs, int rhs) {
+        if (lhs.isZero() || rhs == 0) {
+            return this;
+        }
+        boolean productNegative = multiplySign(lhs.negative, rhs < 0);
+        if ((!isZero() && negative != productNegative) || lhs == this) {
+            return addInPlace(lhs.copy().multiplyInPlace(rhs));
+        }
+
+        long rhsValue = Math.abs((long) rhs); // may exceed BASE
+        expandForMultiplyAdd(lhs.length + 2);
+        int lhsSize = lhs.extent();
+        int i = offset + length - 1 - (lhs.offset + lhs.length - lhsSize); // "trailingZeroesForm"
+        long carry = 0;
+
+        for (int j = lhsSize - 1; j >= lhs.offset; --j, --i) {
+            long value = data[i] + lhs.data[j] * rhsValue + carry;
+            data[i] = (int) (value % BASE);
+            carry = value / BASE;
+        }
+        for (; carry > 0 && i >= offset; --i) {
+            long value = data[i] + carry;
+            data[i] = (int) (value % BASE);
+            carry = value / BASE;
+        }
+
+        if (carry > 0) {
+            expandWith((int) carry);
+        }
+        canonicalize();
+        return setNegative(productNegative);
+    }
+
+    // makes us at least productLength limbs long, plus room for one more
+    private void expandForMultiplyAdd(int productLength) {
+        int by = Math.max(0, productLength - length);
+        ensureCapacity(by + 1);
+        Arrays.fill(data, offset - by, offset, 0);
+        expandBy(by);
+    }
+
+    // result[resultOffset..resultLength - 1] += lhs * rhs, otherwise like multiplyCore(), returns the carry out of result[resultOffset]
+    private static native int multiplyAddCore(
+            int[] result, int resultOffset, int resultLength, int shift,
+            int[] lhs, int lhsOffset, int lhsMax,
+            int[] rhs, int rhsOffset, int rhsMax);
+
     public Int9N addInPlace(Int9N rhs) {
         if (rhs.isZero()) {
             return this;
@@ -773,6 +1236,14 @@ private void addInPlaceAbsLongerEqualCore(int[] rhs, int rhsOffset, int rhsLengt
             rhsMax = rhs.length;
         }
 
+        if (rhsMax - rhsOffset >= NATIVE_ADD_MIN_LENGTH) {
+            int carry = addCore(data, offset, i, rhs, rhsOffset, rhsMax - 1);
+            if (carry > 0) {
+                expandWith(carry);
+            }
+            return;
+        }
+
         for (int j = rhsMax - 1; j >= rhsOffset; --j, --i) {
             accumulator = data[i] + rhs[j] + AddWithCarry.carry(accumulator);
             data[i] = AddWithCarry.value(accumulator);
@@ -783,6 +1254,11 @@ private void addInPlaceAbsLongerEqualCore(int[] rhs, int rhsOffset, int rhsLengt
         }
     }
 
+    // the least significant limbs of lhs[..lhsMax] and rhs[..rhsMax] are aligned, returns the carry out of lhs[lhsOffset]
+    private static native int addCore(
+            int[] lhs, int lhsOffset, int lhsMax,
+            int[] rhs, int rhsOffset, int rhsMax);
+
     public Int9N addInPlace(long rhs) {
         if (rhs == Long.MIN_VALUE) {
             // we can't do absolute (i.e. positive) arithmetic with LONG_MIN
@@ -893,6 +1369,13 @@ private void subtractInPlaceAbsGreaterEqualCore(int[] rhs, int rhsOffset, int rh
             rhsMax = rhs.length;
         }
 
+        if (rhsMax - rhsOffset >= NATIVE_ADD_MIN_LENGTH) {
+            int borrow = subtractCore(data, offset, i, rhs, rhsOffset, rhsMax - 1);
+            assert borrow == 0;
+            canonicalize();
+            return;
+        }
+
         for (int j = rhsMax - 1; j >= rhsOffset; --i, --j) {
             accumulator = data[i] - rhs[j] + SubtractWithCarry.carry(accumulator);
             data[i] = SubtractWithCarry.value(accumulator);
@@ -906,6 +1389,11 @@ private void subtractInPlaceAbsGreaterEqualCore(int[] rhs, int rhsOffset, int rh
         canonicalize();
     }
 
+    // same coordinates as addCore(), returns the borrow out of lhs[lhsOffset]
+    private static native int subtractCore(
+            int[] lhs, int lhsOffset, int lhsMax,
+            int[] rhs, int rhsOffset, int rhsMax);
+
     private void subtractInPlaceAbsLessThan(Int9N rhs) {
         assert length <= rhs.length;
         assert compareToAbs(rhs) < 0; // we are the smaller number
@@ -1085,9 +1573,24 @@ public int modulo(int divisor) {
         return copy().divideInPlace(divisor);
     }
 
+    public Int9N divide(Int9N divisor) {
+        return divide(this, divisor);
+    }
+
+    public Int9N modulo(Int9N divisor) {
+        return modulo(this, divisor);
+    }
+
     public Int9N multiply(Int9N rhs) {
         var pool = forkJoinPool;
-        return pool == null ? multiplyKaratsuba(this, rhs) : parallelMultiplyKaratsuba(this, rhs, pool);
+        if (pool != null) {
+            return parallelMultiplyKaratsuba(this, rhs, pool);
+        }
+        int nttThreshold = tuning().nttThreshold;
+        if (length > nttThreshold && rhs.length > nttThreshold) {
+            return multiplyNtt(this, rhs);
+        }
+        return multiplyToomCook3(this, rhs);
     }
 
     public Int9N pow(int exponent) {
@@ -1101,6 +1604,36 @@ public static void setForkJoinPool(ForkJoinPool pool) {
         forkJoinPool = pool;
     }
 
+    private static Tuning tuning; // null until first used, see tuning()
+
+    /*
+     * Sets the crossovers which all methods without explicit thresholds use, see Tuning.
+     * By default, these are Tuning.DEFAULT, or Tuning.calibrated() if the system property
+     * "philippag.compint.calibrate" is "true".
+     */
+    public static void setTuning(Tuning tuning) {
+        Int9N.tuning = Objects.requireNonNull(tuning, "tuning");
+    }
+
+    public static Tuning getTuning() {
+        return tuning();
+    }
+
+    private static Tuning tuning() {
+        var t = tuning;
+        return t != null ? t : initTuning();
+    }
+
+    private static synchronized Tuning initTuning() {
+        if (tuning == null) {
+            tuning = Tuning.DEFAULT; // also while calibrating
+            if (Boolean.getBoolean(CALIBRATE_PROPERTY)) {
+                tuning = Tuning.calibrated();
+            }
+        }
+        return tuning;
+    }
+
     /* ============================
      * static functional arithmetic
      * ============================
@@ -1231,6 +1764,16 @@ private static int[] multiplyImpl(
             int[] rhs, int rhsOffset, int rhsLength) {
 
         int[] result = new int[lhsLength + rhsLength];
+        multiplyImpl(result, result.length, lhs, lhsOffset, lhsLength, rhs, rhsOffset, rhsLength);
+        return result;
+    }
+
+    // the product goes to result[resultLength - lhsLength - rhsLength, resultLength), which must be zero
+    private static void multiplyImpl(
+            int[] result, int resultLength,
+            int[] lhs, int lhsOffset, int lhsLength,
+            int[] rhs, int rhsOffset, int rhsLength) {
+
         int lhsSize = lhsOffset + lhsLength;
         int rhsSize = rhsOffset + rhsLength;
         int shift = 1;
@@ -1244,8 +1787,31 @@ private static int[] multiplyImpl(
             shift += rhsSize - rhs.length;
             rhsSize = rhs.length;
         }
-        multiplyCore(result, result.length, shift, lhs, lhsOffset, lhsSize - 1, rhs, rhsOffset, rhsSize - 1);
-        return result;
+        boolean counting = stats;
+        long start = counting ? System.nanoTime() : 0;
+        boolean foreign = foreignMultiply;
+        if (lhs == rhs && lhsOffset == rhsOffset && lhsLength == rhsLength) {
+            if (foreign) {
+                Foreign.squareCore(result, resultLength, shift, lhs, lhsOffset, lhsSize - 1);
+            } else {
+                squareCore(result, resultLength, shift, lhs, lhsOffset, lhsSize - 1);
+            }
+        } else if (columnsMultiply && lhsLength <= COLUMNS_MULTIPLY_MAX_LENGTH && rhsLength <= COLUMNS_MULTIPLY_MAX_LENGTH) {
+            if (foreign) {
+                Foreign.multiplyColumnsCore(result, resultLength, shift, lhs, lhsOffset, lhsSize - 1, rhs, rhsOffset, rhsSize - 1);
+            } else {
+                multiplyColumnsCore(result, resultLength, shift, lhs, lhsOffset, lhsSize - 1, rhs, rhsOffset, rhsSize - 1);
+            }
+        } else {
+            if (foreign) {
+                Foreign.multiplyCore(result, resultLength, shift, lhs, lhsOffset, lhsSize - 1, rhs, rhsOffset, rhsSize - 1);
+            } else {
+                multiplyCore(result, resultLength, shift, lhs, lhsOffset, lhsSize - 1, rhs, rhsOffset, rhsSize - 1);
+            }
+        }
+        if (counting) {
+            Stats.record(Stats.Kind.SCHOOLBOOK, lhsLength, rhsLength, start);
+        }
     }
 
     private static native void multiplyCore(
@@ -1253,6 +1819,42 @@ private static native void multiplyCore(
             int[] lhs, int lhsOffset, int lhsMax,
             int[] rhs, int rhsOffset, int rhsMax);
 
+    private static native void multiplyColumnsCore(
+            int[] result, int resultLength, int shift,
+            int[] lhs, int lhsOffset, int lhsMax,
+            int[] rhs, int rhsOffset, int rhsMax);
+
+    private static native void squareCore(
+            int[] result, int resultLength, int shift,
+            int[] lhs, int lhsOffset, int lhsMax);
+
+    private static native boolean multiplyCoreVectorized();
+
+    /*
+     * multiplyColumnsCore() sums up each result limb in one go (product scanning),
+     * which beats multiplyCore() for short operands unless the latter runs on SIMD,
+     * hence it is the default only if the CPU has no AVX2.
+     */
+    private static volatile boolean columnsMultiply = nativeLibAvailable && !multiplyCoreVectorized();
+
+    public static void setColumnsMultiply(boolean enabled) {
+        columnsMultiply = enabled;
+    }
+
+    public static boolean isColumnsMultiply() {
+        return columnsMultiply;
+    }
+
+    /*
+     * Calls the long multiplication kernels through java.lang.foreign downcalls instead of JNI,
+     * which costs less per call, see Foreign.
+     */
+    private static volatile boolean foreignMultiply;
+
+    public static void setForeignMultiply(boolean enabled) {
+        foreignMultiply = enabled;
+    }
+
     public static Int9N multiplyRussianPeasant(Int9N lhs, Int9N rhs) {
         return multiplyRussianPeasantForward(lhs, rhs).multiplySign(lhs, rhs);
     }
@@ -1374,7 +1976,7 @@ public int divideInPlace(int divisorArg) {
         } else if (divisor == 3) {
             carry = divideInPlaceAbsBy3();
         } else {
-            carry = divideInPlaceAbsDivMod(divisor);
+            carry = divideIntCore(data, offset, offset + length - 1, divisor);
         }
 
         canonicalize();
@@ -1413,83 +2015,521 @@ private long divideInPlaceAbsBy3() {
         return carry;
     }
 
-    private long divideInPlaceAbsDivMod(long divisor) {
-        long carry = 0;
-        for (int i = offset, max = offset + length; i < max; i++) {
-            long value = data[i] + carry * BASE1;
-            long quot = value / divisor;
-            carry     = value % divisor;
-            assert quot == (int) quot;
-            data[i] = (int) quot;
+    /*
+     * Multiplies by a reciprocal of the divisor computed once, instead of dividing every limb.
+     */
+    private static native long divideIntCore(int[] lhs, int lhsOffset, int lhsMax, long divisor);
+
+    /*
+     * Returns the remainders of this number divided by each of the divisors,
+     * with the sign of this number, like modulo(int).
+     * This reads the limbs once for every 4 divisors, e.g. for trial division.
+     */
+    public int[] modulo(int[] divisors) {
+        for (int divisor : divisors) {
+            if (divisor == 0) {
+                throw new ArithmeticException("Division by zero");
+            }
         }
-        return carry;
+        int[] remainders = new int[divisors.length];
+        int size = extent();
+        moduloIntsCore(data, offset, size - 1, offset + length - size, divisors, remainders);
+        if (negative) {
+            for (int i = 0; i < remainders.length; i++) {
+                remainders[i] = -remainders[i];
+            }
+        }
+        return remainders;
     }
 
-    public boolean isEven() {
-        return (get(length - 1) & 1) == 0;
-    }
+    private static native void moduloIntsCore(
+            int[] lhs, int lhsOffset, int lhsMax, int lhsZeroes,
+            int[] divisors, int[] remainders);
 
-    public static Int9N pow(Int9N base, int exponent) {
-        return pow(base, exponent, KARATSUBA_THRESHOLD);
+    public static Int9N divide(Int9N lhs, Int9N rhs) {
+        return divideAndModulo(lhs, rhs)[0];
     }
 
-    public static Int9N pow(Int9N base, int exponent, int threshold) {
-        var result = Constants.ONE();
+    public static Int9N modulo(Int9N lhs, Int9N rhs) {
+        return divideAndModulo(lhs, rhs)[1];
+    }
 
-        while (exponent > 0) {
-            if ((exponent & 1) != 0) {
-                result = multiplyKaratsuba(result, base, threshold);
-                exponent--;
-            }
+    public static Int9N[] divideAndModulo(Int9N lhs, Int9N rhs) {
+        return divideAndModulo(lhs, rhs, NEWTON_DIVISION_THRESHOLD);
+    }
 
-            exponent >>= 1;
-            base = multiplyKaratsuba(base, base, threshold); // square
+    /*
+     * Returns quotient and remainder, like java.math.BigInteger.divideAndRemainder():
+     * the quotient is rounded towards zero, the remainder has the sign of the dividend.
+     * Uses Knuth's Algorithm D, unless both the divisor and the quotient are longer than
+     * `newtonThreshold` limbs, then the divisor's reciprocal is computed by Newton iteration,
+     * which turns the division into a few multiplications.
+     */
+    public static Int9N[] divideAndModulo(Int9N lhs, Int9N rhs, int newtonThreshold) {
+        if (newtonThreshold < 1) {
+            throw new IllegalArgumentException("Illegal threshold: " + newtonThreshold);
         }
-
+        if (rhs.isZero()) {
+            throw new ArithmeticException("Division by zero");
+        }
+        var result = divideAndModuloForward(lhs, rhs, newtonThreshold);
+        result[0].multiplySign(lhs, rhs);
+        result[1].setNegative(lhs.negative);
         return result;
     }
 
-    public static Int9N parallelPow(Int9N base, int exponent, ForkJoinPool pool) {
-        return parallelPow(base, exponent, KARATSUBA_THRESHOLD, Calc.maxDepth(pool), pool);
+    private static Int9N[] divideAndModuloForward(Int9N lhs, Int9N rhs, int newtonThreshold) {
+        if (lhs.compareToAbs(rhs) < 0) {
+            // don't reuse references b/c of mutability!
+            return new Int9N[] { Constants.ZERO(), lhs.copy() };
+        }
+        if (rhs.length == 1) {
+            var quotient = lhs.copy().setNegative(false);
+            int remainder = quotient.divideInPlace(rhs.get(0));
+            return new Int9N[] { quotient, fromInt(remainder) };
+        }
+        int quotientLength = lhs.length - rhs.length + 1;
+        if (Math.min(rhs.length, quotientLength) > newtonThreshold) {
+            return divideNewtonImpl(lhs, rhs, newtonThreshold);
+        } else {
+            return divideKnuthImpl(lhs, rhs);
+        }
     }
 
-    public static Int9N parallelPow(Int9N base, int exponent, int threshold, int maxDepth, ForkJoinPool pool) {
-        var result = Constants.ONE();
+    private static Int9N[] divideKnuthImpl(Int9N lhs, Int9N rhs) {
+        assert lhs.length >= rhs.length;
+        assert rhs.canonicalized();
+
+        int lhsSize = lhs.extent();
+        int rhsSize = rhs.extent();
+        int[] quotient = new int[lhs.length - rhs.length + 1];
+        int[] remainder = new int[rhs.length];
+        int[] scratch = ScratchArena.scratch(lhs.length + rhs.length + 1);
+        divideCore(quotient, remainder,
+                lhs.data, lhs.offset, lhsSize - 1, lhs.offset + lhs.length - lhsSize,
+                rhs.data, rhs.offset, rhsSize - 1, rhs.offset + rhs.length - rhsSize,
+                scratch);
+        return new Int9N[] { new Int9N(quotient).canonicalize(), new Int9N(remainder).canonicalize() };
+    }
+
+    private static native void divideCore(
+            int[] quotient, int[] remainder,
+            int[] lhs, int lhsOffset, int lhsMax, int lhsZeroes,
+            int[] rhs, int rhsOffset, int rhsMax, int rhsZeroes,
+            int[] scratch);
 
-        while (exponent > 0) {
-            if ((exponent & 1) != 0) {
-                result = parallelMultiplyKaratsuba(result, base, threshold, maxDepth, pool);
-                exponent--;
+    /*
+     * With y = floor(B^2m / rhs), where rhs has m limbs, each m limbs of the quotient
+     * can be estimated as floor(c * y / B^2m), where c = remainder * B^m + next m limbs of lhs.
+     * The estimate is at most 2 too small.
+     */
+    private static Int9N[] divideNewtonImpl(Int9N lhs, Int9N rhs, int newtonThreshold) {
+        int n = lhs.length;
+        int m = rhs.length;
+        var reciprocal = reciprocal(rhs, newtonThreshold);
+        int blocks = (n + m - 1) / m;
+        int[] quotient = new int[blocks * m];
+        var remainder = Constants.ZERO();
+
+        for (int block = 0, from = 0, to = n - (blocks - 1) * m; block < blocks; block++, from = to, to += m) {
+            var current = add(remainder.shiftLeft(m), lhs.limbs(from, to));
+            var digits = multiplyAdaptive(current, reciprocal).shiftRightLimbs(2 * m);
+            remainder = subtract(current, multiplyAdaptive(digits, rhs));
+            assert !remainder.negative;
+            while (remainder.compareToAbs(rhs) >= 0) {
+                digits.incrementInPlace();
+                remainder = subtract(remainder, rhs);
             }
+            assert digits.length <= m;
+            for (int i = 0, j = (block + 1) * m - digits.length; i < digits.length; i++, j++) {
+                quotient[j] = digits.get(i);
+            }
+        }
+        return new Int9N[] { new Int9N(quotient).canonicalize(), remainder };
+    }
 
-            exponent >>= 1;
-            base = parallelMultiplyKaratsuba(base, base, threshold, maxDepth, pool); // square
+    /*
+     * floor(B^2m / b), where b has m limbs.
+     * Starts with the reciprocal of the top h limbs of b, which Newton's step
+     * y += y * (B^2m - b * y) / B^2m makes exact up to a few units,
+     * as h includes 2 guard limbs beyond half of m.
+     */
+    private static Int9N reciprocal(Int9N b, int newtonThreshold) {
+        int m = b.length;
+        int h = (m + 5) >> 1;
+        var power = Constants.ONE().shiftLeft(2 * m);
+        if (m <= newtonThreshold || h >= m) {
+            return divideKnuthImpl(power, b)[0];
         }
 
-        return result;
-    }
+        var y = reciprocal(b.limbs(0, h), newtonThreshold).shiftLeft(m - h);
+        var error = subtract(power, multiplyAdaptive(b, y));
+        y = add(y, multiplyAdaptive(y, error).shiftRightLimbs(2 * m));
 
-    //@VisibleForTesting
-    Int9N leftPart(int n) {
-        if ((n >> 1) >= length) {
-            return ZERO;
-        } else {
-            return new Int9N(data, offset, ((n + 1) >> 1) + length - n);
+        error = subtract(power, multiplyAdaptive(b, y));
+        while (error.negative) {
+            y.decrementInPlace();
+            error = add(error, b);
+        }
+        while (error.compareToAbs(b) >= 0) {
+            y.incrementInPlace();
+            error = subtract(error, b);
         }
+        return y;
     }
 
-    //@VisibleForTesting
-    Int9N rightPart(int n) {
-        if ((n >> 1) >= length) {
-            return this;
-        } else {
-            int newOffset = offset + ((n + 1) >> 1) + length - n;
-            return newOffset < data.length ? new Int9N(data, newOffset, n >> 1).canonicalize() : ZERO;
+    // limbs [from, to) as a new number
+    private Int9N limbs(int from, int to) {
+        assert 0 <= from && from < to && to <= length;
+        int[] result = new int[to - from];
+        for (int i = 0; i < result.length; i++) {
+            result[i] = get(from + i);
+        }
+        return new Int9N(result).canonicalize();
+    }
+
+    // this / B^by, rounded towards zero, as a new number
+    private Int9N shiftRightLimbs(int by) {
+        return by < length ? limbs(0, length - by).setNegative(negative) : Constants.ZERO();
+    }
+
+    /*
+     * Multiplies this number in-place by 10^digits.
+     * Whole limbs only become more implicit trailing zero limbs,
+     * the other (up to 8) digits move across the stored limbs in one pass.
+     */
+    public Int9N shiftDecimalLeft(int digits) {
+        if (digits < 0) {
+            throw new IllegalArgumentException("Illegal shift: " + digits);
+        }
+        if (digits == 0 || isZero()) {
+            return this;
+        }
+        int limbs = DivMulTable.div9(digits);
+        int rest = DivMulTable.mod9(limbs, digits);
+        if (limbs >= Integer.MAX_VALUE - length) {
+            throw new ArithmeticException("Shift too long: " + digits);
+        }
+        if (rest > 0) {
+            int high = shiftDigits(data, offset, extent(), rest);
+            if (high > 0) {
+                if (offset == 0) {
+                    // not resize(1), which would copy the implicit trailing zero limbs, too
+                    int[] newData = new int[data.length + 1];
+                    System.arraycopy(data, 0, newData, 1, data.length);
+                    data = newData;
+                    offset = 1;
+                }
+                expandWith(high);
+            }
+        }
+        return shiftLeft(limbs);
+    }
+
+    /*
+     * Divides this number in-place by 10^digits, rounded towards zero like divideInPlace().
+     * Whole limbs are dropped, the other (up to 8) digits move across the rest in one pass.
+     */
+    public Int9N shiftDecimalRight(int digits) {
+        if (digits < 0) {
+            throw new IllegalArgumentException("Illegal shift: " + digits);
+        }
+        if (digits == 0 || isZero()) {
+            return this;
+        }
+        int limbs = DivMulTable.div9(digits);
+        int rest = DivMulTable.mod9(limbs, digits);
+        if (limbs >= length) {
+            clear();
+            return this;
+        }
+        int newLength = length - limbs;
+        int stored = extent();
+        if (offset + newLength < stored) {
+            // a later shiftLeft() must find zeroes there
+            Arrays.fill(data, offset + newLength, stored, 0);
+        }
+        length = newLength;
+        if (rest > 0) {
+            if (trailingZeroesForm()) {
+                // the lowest digits move into the first implicit zero limb
+                data = copyFullSizeArray();
+                offset = 0;
+            }
+            shiftDigits(data, offset, offset + length, -rest);
+        }
+        return canonicalize();
+    }
+
+    /*
+     * Moves the digits of data[from..to) by 0 < |digits| < SIZE, to the left (more significant) if digits > 0.
+     * Returns the digits pushed out of data[from] (left) or data[to - 1] (right).
+     */
+    private static int shiftDigits(int[] data, int from, int to, int digits) {
+        if (nativeLibAvailable && to - from >= NATIVE_ADD_MIN_LENGTH) {
+            return shiftDigitsCore(data, from, to, digits);
+        }
+        int carry = 0;
+        if (digits > 0) {
+            int idx = digits - 1; // 10^(SIZE - digits) for DivMulTable
+            int scale = SIZE - 1 - digits; // 10^digits
+            for (int i = to - 1; i >= from; --i) {
+                int value = data[i];
+                int high = DivMulTable.divPower10(value, idx);
+                data[i] = DivMulTable.mulPower10(value - DivMulTable.mulPower10(high, idx), scale) + carry;
+                carry = high;
+            }
+        } else {
+            int idx = SIZE - 1 + digits; // 10^-digits for DivMulTable
+            int scale = -digits - 1; // 10^(SIZE + digits)
+            for (int i = from; i < to; i++) {
+                int value = data[i];
+                int high = DivMulTable.divPower10(value, idx);
+                data[i] = high + DivMulTable.mulPower10(carry, scale);
+                carry = value - DivMulTable.mulPower10(high, idx);
+            }
+        }
+        return carry;
+    }
+
+    // see shiftDigits(), uses the reciprocals of DivMulTable, too
+    private static native int shiftDigitsCore(int[] data, int from, int to, int digits);
+
+    public boolean isEven() {
+        return (get(length - 1) & 1) == 0;
+    }
+
+    public static Int9N pow(Int9N base, int exponent) {
+        return pow(base, exponent, tuning().karatsubaThreshold);
+    }
+
+    public static Int9N pow(Int9N base, int exponent, int threshold) {
+        return pow(base, exponent, threshold, windowBits(exponent));
+    }
+
+    /*
+     * Sliding-window exponentiation with the odd powers of the base up to base^(2^windowBits - 1).
+     * Trailing zero limbs of the base are shifted in afterwards, and a single-limb base
+     * is raised natively into a presized buffer, see pow_int() in int9.c.
+     */
+    public static Int9N pow(Int9N base, int exponent, int threshold, int windowBits) {
+        if (windowBits < 1 || windowBits > MAX_WINDOW_BITS) {
+            throw new IllegalArgumentException("Illegal window size: " + windowBits);
+        }
+        int toomCook3Threshold = Math.max(threshold, tuning().toomCook3Threshold);
+        return powImpl(base, exponent, windowBits, threshold, toomCook3Threshold,
+                (lhs, rhs) -> multiplyAdaptive(lhs, rhs, threshold, toomCook3Threshold));
+    }
+
+    public static Int9N parallelPow(Int9N base, int exponent, ForkJoinPool pool) {
+        var tuning = tuning();
+        return parallelPow(base, exponent, tuning.karatsubaThreshold, tuning.parallelThreshold, tuning.maxDepth, pool);
+    }
+
+    public static Int9N parallelPow(Int9N base, int exponent, int threshold, int maxDepth, ForkJoinPool pool) {
+        return parallelPow(base, exponent, threshold, threshold, maxDepth, pool);
+    }
+
+    private static Int9N parallelPow(Int9N base, int exponent, int threshold, int parallelThreshold, int maxDepth, ForkJoinPool pool) {
+        return powImpl(base, exponent, windowBits(exponent), threshold, Math.max(threshold, tuning().toomCook3Threshold),
+                (lhs, rhs) -> parallelMultiplyKaratsuba(lhs, rhs, threshold, parallelThreshold, maxDepth, pool));
+    }
+
+    // the table of odd powers costs 2^(windowBits - 1) multiplications of short numbers, it pays off for long exponents only
+    private static int windowBits(int exponent) {
+        int bits = Integer.SIZE - Integer.numberOfLeadingZeros(exponent);
+        return bits <= 4 ? 1 : bits <= 12 ? 2 : bits <= 24 ? 3 : 4;
+    }
+
+    private static Int9N powImpl(Int9N base, int exponent, int windowBits, int karatsubaThreshold, int toomCook3Threshold,
+            BinaryOperator<Int9N> multiply) {
+        if (exponent <= 0) {
+            return Constants.ONE();
+        }
+        if (base.isZero()) {
+            return Constants.ZERO();
+        }
+        int zeroLimbs = base.trailingZeroLimbs();
+        var core = base.limbs(0, base.length - zeroLimbs);
+        Int9N result = null;
+        if (core.length == 1) {
+            result = core.data[0] == 1 ? core : powInt(core.data[0], exponent, karatsubaThreshold, toomCook3Threshold);
+        }
+        if (result == null) {
+            result = powWindow(core, exponent, windowBits, multiply);
+        }
+        long shift = (long) zeroLimbs * exponent;
+        if (shift > Integer.MAX_VALUE - result.length) {
+            throw new ArithmeticException("Power too long: " + shift + " zero limbs");
+        }
+        return result.shiftLeft((int) shift).setNegative(base.negative && (exponent & 1) != 0);
+    }
+
+    // left to right, for a positive exponent, `base` itself takes part in the products only
+    private static Int9N powWindow(Int9N base, int exponent, int windowBits, BinaryOperator<Int9N> multiply) {
+        var powers = new Int9N[1 << (windowBits - 1)]; // base^1, base^3, base^5, ...
+        powers[0] = base;
+        if (powers.length > 1) {
+            var square = multiply.apply(base, base);
+            for (int i = 1; i < powers.length; i++) {
+                powers[i] = multiply.apply(powers[i - 1], square);
+            }
+        }
+
+        Int9N result = null;
+        int bit = Integer.SIZE - 1 - Integer.numberOfLeadingZeros(exponent);
+        while (bit >= 0) {
+            if ((exponent >>> bit & 1) == 0) {
+                result = multiply.apply(result, result);
+                bit--;
+                continue;
+            }
+            // the longest window of at most windowBits bits from here, ending with a set bit
+            int low = Math.max(bit - windowBits + 1, 0);
+            while ((exponent >>> low & 1) == 0) {
+                low++;
+            }
+            var power = powers[(exponent >>> low & ((1 << (bit - low + 1)) - 1)) >> 1];
+            if (result == null) {
+                result = power;
+            } else {
+                for (int i = low; i <= bit; i++) {
+                    result = multiply.apply(result, result);
+                }
+                result = multiply.apply(result, power);
+            }
+            bit = low - 1;
+        }
+        return result;
+    }
+
+    // number of zero limbs at the right, including the ones of "trailingZeroesForm", for a non-zero number
+    private int trailingZeroLimbs() {
+        int count = offset + length - extent();
+        for (int i = extent() - 1; i > offset && data[i] == 0; i--) {
+            count++;
+        }
+        return count;
+    }
+
+    /*
+     * base^exponent for 2 <= base < BASE, computed in one native call on the calling thread's direct buffer,
+     * with the result length estimated (generously) up front. Returns null if that doesn't fit into a ByteBuffer.
+     */
+    private static Int9N powInt(int base, int exponent, int karatsubaThreshold, int toomCook3Threshold) {
+        long resultLength = (long) (exponent * Math.log10(base) / SIZE) + 3;
+        if (resultLength > Integer.MAX_VALUE / Integer.BYTES) {
+            return null;
+        }
+        int nttThreshold = tuning().nttThreshold;
+        long scratchLength = powIntScratchLength((int) resultLength, karatsubaThreshold, toomCook3Threshold, nttThreshold);
+        var buffer = OffHeap.buffer(resultLength + scratchLength);
+        if (buffer == null) {
+            return null;
+        }
+        powIntDirectCore(buffer, base, exponent, 0, (int) resultLength, (int) resultLength,
+                karatsubaThreshold, toomCook3Threshold, nttThreshold);
+        int[] result = new int[(int) resultLength];
+        buffer.asIntBuffer().get(0, result);
+        return new Int9N(result).canonicalize();
+    }
+
+    private static native long powIntScratchLength(int resultLength, int karatsubaThreshold, int toomCook3Threshold, int nttThreshold);
+
+    private static native void powIntDirectCore(
+            ByteBuffer buffer, int base, int exponent,
+            int resultIndex, int resultLength,
+            int scratchIndex, int karatsubaThreshold, int toomCook3Threshold, int nttThreshold);
+
+    // sums up the numbers of a (parallel) stream, see Accumulator
+    public static Collector<Int9N, ?, Int9N> summing() {
+        return Collector.of(Accumulator::new, Accumulator::add, Accumulator::addAll, Accumulator::sum, Collector.Characteristics.UNORDERED);
+    }
+
+    /*
+     * The product of all factors (1 for none) as a tree of multiplications, whose nodes split
+     * their factors into halves of about the same length, so that both operands are balanced.
+     * Leaves up to the Karatsuba threshold are multiplied from left to right, in place.
+     * With setForkJoinPool(), subtrees above the parallel threshold (see Tuning) run as tasks of that pool.
+     */
+    public static Int9N product(Int9N... factors) {
+        return product(Arrays.asList(factors));
+    }
+
+    public static Int9N product(List<Int9N> factors) {
+        if (factors.isEmpty()) {
+            return Constants.ONE();
+        }
+        var array = factors.toArray(new Int9N[0]);
+        long[] lengths = new long[array.length + 1]; // lengths[i] = sum of the lengths of factors [0, i)
+        for (int i = 0; i < array.length; i++) {
+            lengths[i + 1] = lengths[i] + array[i].length;
+        }
+        var tuning = tuning();
+        var pool = forkJoinPool;
+        return pool == null
+                ? productTree(array, lengths, 0, array.length, tuning, /*parallel*/ false)
+                : pool.invoke(task(() -> productTree(array, lengths, 0, array.length, tuning, /*parallel*/ true)));
+    }
+
+    // the ints are first multiplied into leaves of Karatsuba threshold length
+    public static Int9N product(int[] factors) {
+        int leafLength = tuning().karatsubaThreshold;
+        var leaves = new ArrayList<Int9N>();
+        var leaf = Constants.ONE();
+        for (int factor : factors) {
+            leaf.multiplyInPlace(factor);
+            if (leaf.length >= leafLength) {
+                leaves.add(leaf);
+                leaf = Constants.ONE();
+            }
+        }
+        leaves.add(leaf);
+        return product(leaves);
+    }
+
+    private static Int9N productTree(Int9N[] factors, long[] lengths, int from, int to, Tuning tuning, boolean parallel) {
+        long length = lengths[to] - lengths[from];
+        if (to - from == 1 || length <= tuning.karatsubaThreshold) {
+            var result = factors[from].copy();
+            for (int i = from + 1; i < to; i++) {
+                result.multiplyInPlace(factors[i]);
+            }
+            return result;
+        }
+        // the first split point at or after half of the length, leaving at least one factor on either side
+        int mid = Arrays.binarySearch(lengths, from + 1, to, lengths[from] + length / 2);
+        mid = Math.min(mid < 0 ? -mid - 1 : mid, to - 1);
+        if (parallel && length > tuning.parallelThreshold) {
+            int split = mid;
+            var right = task(() -> productTree(factors, lengths, split, to, tuning, parallel)).fork();
+            var left = productTree(factors, lengths, from, mid, tuning, parallel);
+            return left.multiply(right.join());
+        }
+        return productTree(factors, lengths, from, mid, tuning, parallel).multiply(productTree(factors, lengths, mid, to, tuning, parallel));
+    }
+
+    //@VisibleForTesting
+    Int9N leftPart(int n) {
+        if ((n >> 1) >= length) {
+            return ZERO;
+        } else {
+            return new Int9N(data, offset, ((n + 1) >> 1) + length - n);
+        }
+    }
+
+    //@VisibleForTesting
+    Int9N rightPart(int n) {
+        if ((n >> 1) >= length) {
+            return this;
+        } else {
+            int newOffset = offset + ((n + 1) >> 1) + length - n;
+            return newOffset < data.length ? new Int9N(data, newOffset, n >> 1).canonicalize() : ZERO;
         }
     }
 
     public static Int9N multiplyKaratsuba(Int9N lhs, Int9N rhs) {
-        return multiplyKaratsuba(lhs, rhs, KARATSUBA_THRESHOLD);
+        return multiplyKaratsuba(lhs, rhs, tuning().karatsubaThreshold);
     }
 
     public static Int9N multiplyKaratsuba(Int9N lhs, Int9N rhs, int threshold) {
@@ -1500,104 +2540,348 @@ public static Int9N multiplyKaratsuba(Int9N lhs, Int9N rhs, int threshold) {
     }
 
     private static Int9N multiplyKaratsubaForward(Int9N lhs, Int9N rhs, int threshold) {
-        if (lhs.length <= threshold || rhs.length <= threshold) {
+        return multiplySubquadraticForward(lhs, rhs, threshold, Integer.MAX_VALUE);
+    }
+
+    public static Int9N multiplyToomCook3(Int9N lhs, Int9N rhs) {
+        var tuning = tuning();
+        return multiplyToomCook3(lhs, rhs, tuning.karatsubaThreshold, tuning.toomCook3Threshold);
+    }
+
+    /*
+     * Uses Toom-Cook-3 for operands longer than `toomCook3Threshold`,
+     * Karatsuba for operands longer than `karatsubaThreshold`,
+     * and long multiplication for everything else.
+     */
+    public static Int9N multiplyToomCook3(Int9N lhs, Int9N rhs, int karatsubaThreshold, int toomCook3Threshold) {
+        if (karatsubaThreshold < 1) {
+            throw new IllegalArgumentException("Illegal threshold: " + karatsubaThreshold);
+        }
+        if (toomCook3Threshold < karatsubaThreshold) {
+            throw new IllegalArgumentException("Illegal Toom-Cook-3 threshold: " + toomCook3Threshold);
+        }
+        return multiplySubquadraticForward(lhs, rhs, karatsubaThreshold, toomCook3Threshold).multiplySign(lhs, rhs);
+    }
+
+    private static Int9N multiplySubquadraticForward(Int9N lhs, Int9N rhs, int karatsubaThreshold, int toomCook3Threshold) {
+        if (lhs.length <= karatsubaThreshold || rhs.length <= karatsubaThreshold) {
             return multiplySimpleForward(lhs, rhs);
         } else {
-            return multiplyKaratsubaImpl(lhs, rhs, threshold);
+            return multiplySubquadraticImpl(lhs, rhs, karatsubaThreshold, toomCook3Threshold);
         }
     }
 
-    private static Int9N multiplyKaratsubaImpl(Int9N lhs, Int9N rhs, int threshold) {
-        assert threshold >= 1;
+    /*
+     * The recursion (split, evaluate, sub-products, interpolate, recombine)
+     * runs entirely in native code, see mul_karatsuba() and mul_toom3() in int9.c.
+     * All temporaries live in one scratch array allocated up front.
+     */
+    private static Int9N multiplySubquadraticImpl(Int9N lhs, Int9N rhs, int karatsubaThreshold, int toomCook3Threshold) {
+        assert karatsubaThreshold >= 1;
+        assert toomCook3Threshold >= karatsubaThreshold;
         assert !(lhs.length == 1 && rhs.length == 1); // too low threshold
 
-        int n = Math.max(lhs.length, rhs.length);
-        var a = lhs.leftPart(n);
-        var b = lhs.rightPart(n);
-        var c = rhs.leftPart(n);
-        var d = rhs.rightPart(n);
-        var ac = multiplyKaratsubaForward(a, c, threshold);
-        var bd = multiplyKaratsubaForward(b, d, threshold);
-        var middle = multiplyKaratsubaForward(
-                addAbs(a, b),
-                addAbs(c, d),
-                threshold
-        );
+        int[] result = multiplySubquadraticImpl(lhs.data, lhs.offset, lhs.length, rhs.data, rhs.offset, rhs.length, karatsubaThreshold, toomCook3Threshold);
+        return new Int9N(result).canonicalize();
+    }
 
-        /*
-         * We use the distributive law here:
-         * `middle` is currently `(a + b) * (c + d)`,
-         * which distributes to
-         * `ac + ad + bc + bd`.
-         * Now, we subtract the 2 products `ac` and `bd` (below)
-         * so `middle` equals `ad + bc`.
-         */
-        middle.subtractInPlaceAbsGreaterEqual(ac);
-        middle.subtractInPlaceAbsGreaterEqual(bd);
-        var result = new Int9N(new int[lhs.length + rhs.length]);
-        /*
-         * add up the left (biggest) part `ac` expanded to the full power,
-         * with the middle part `middle`, expanded to the half power,
-         * and the right (smallest) part `bd` (expanded to zero power).
-         */
-        int half = n >> 1;
-        result.addInPlaceAbsLongerEqual(ac.shiftLeft(half << 1));
-        result.addInPlaceAbsLongerEqual(middle.shiftLeft(half));
-        result.addInPlaceAbsLongerEqual(bd);
-        return result.canonicalize();
+    private static int[] multiplySubquadraticImpl(
+            int[] lhs, int lhsOffset, int lhsLength,
+            int[] rhs, int rhsOffset, int rhsLength,
+            int karatsubaThreshold, int toomCook3Threshold) {
+
+        int[] result = new int[lhsLength + rhsLength];
+        multiplySubquadraticImpl(result, result.length, lhs, lhsOffset, lhsLength, rhs, rhsOffset, rhsLength, karatsubaThreshold, toomCook3Threshold);
+        return result;
     }
 
-    public static Int9N parallelMultiplyKaratsuba(Int9N lhs, Int9N rhs, ForkJoinPool pool) {
-        return parallelMultiplyKaratsuba(lhs, rhs, KARATSUBA_THRESHOLD, Calc.maxDepth(pool), pool);
+    // like multiplyImpl(), into result[..resultLength)
+    private static void multiplySubquadraticImpl(
+            int[] result, int resultLength,
+            int[] lhs, int lhsOffset, int lhsLength,
+            int[] rhs, int rhsOffset, int rhsLength,
+            int karatsubaThreshold, int toomCook3Threshold) {
+
+        int lhsSize = lhsOffset + lhsLength;
+        int rhsSize = rhsOffset + rhsLength;
+        int shift = 1;
+
+        // fix coordinates for "trailingZeroesForm"
+        if (lhsSize > lhs.length) {
+            shift += lhsSize - lhs.length;
+            lhsSize = lhs.length;
+        }
+        if (rhsSize > rhs.length) {
+            shift += rhsSize - rhs.length;
+            rhsSize = rhs.length;
+        }
+        boolean counting = stats;
+        long start = counting ? System.nanoTime() : 0;
+        long scratchLength = multiplyScratchLength(lhsSize - lhsOffset, rhsSize - rhsOffset, karatsubaThreshold, toomCook3Threshold);
+        var offHeap = offHeapMultiply ? OffHeap.stage(lhs, lhsOffset, lhsSize - lhsOffset, rhs, rhsOffset, rhsSize - rhsOffset, scratchLength) : null;
+        if (offHeap != null) {
+            multiplySubquadraticDirectCore(offHeap.buffer, offHeap.resultIndex, 0, offHeap.lhsLength, offHeap.rhsIndex, offHeap.rhsLength,
+                    offHeap.scratchIndex, karatsubaThreshold, toomCook3Threshold);
+            offHeap.copyProduct(result, resultLength, shift);
+        } else {
+            int[] scratch = ScratchArena.scratch(scratchLength);
+            multiplySubquadraticCore(result, resultLength, shift, lhs, lhsOffset, lhsSize - 1, rhs, rhsOffset, rhsSize - 1,
+                    scratch, karatsubaThreshold, toomCook3Threshold);
+        }
+        if (counting) {
+            Stats.record(Stats.Kind.KARATSUBA, lhsLength, rhsLength, start);
+        }
     }
 
-    public static Int9N parallelMultiplyKaratsuba(Int9N lhs, Int9N rhs, int threshold, int maxDepth, ForkJoinPool pool) {
-        if (threshold < 1) {
-            throw new IllegalArgumentException("Illegal threshold: " + threshold);
+    private static native long multiplyScratchLength(int lhsLength, int rhsLength, int karatsubaThreshold, int toomCook3Threshold);
+
+    private static native void multiplySubquadraticCore(
+            int[] result, int resultLength, int shift,
+            int[] lhs, int lhsOffset, int lhsMax,
+            int[] rhs, int rhsOffset, int rhsMax,
+            int[] scratch, int karatsubaThreshold, int toomCook3Threshold);
+
+    private static native void multiplySubquadraticDirectCore(
+            ByteBuffer buffer, int resultIndex,
+            int lhsIndex, int lhsLength,
+            int rhsIndex, int rhsLength,
+            int scratchIndex, int karatsubaThreshold, int toomCook3Threshold);
+
+    private static Int9N multiplyAdaptive(Int9N lhs, Int9N rhs) {
+        var tuning = tuning();
+        return multiplyAdaptive(lhs, rhs, tuning.karatsubaThreshold, tuning.toomCook3Threshold);
+    }
+
+    private static Int9N multiplyAdaptive(Int9N lhs, Int9N rhs, int karatsubaThreshold, int toomCook3Threshold) {
+        int nttThreshold = tuning().nttThreshold;
+        if (lhs.length > nttThreshold && rhs.length > nttThreshold) {
+            return multiplyNtt(lhs, rhs);
+        } else {
+            return multiplyToomCook3(lhs, rhs, karatsubaThreshold, toomCook3Threshold);
         }
-        if (maxDepth < 1) {
-            throw new IllegalArgumentException("Illegal maxDepth: " + maxDepth);
+    }
+
+    /*
+     * O(n log n) multiplication via number-theoretic transforms, see mul_ntt() in int9.c.
+     * The transform length is limited to 2^26 limbs (both operands together),
+     * beyond that we fall back to Toom-Cook-3.
+     */
+    public static Int9N multiplyNtt(Int9N lhs, Int9N rhs) {
+        return multiplyNttForward(lhs, rhs).multiplySign(lhs, rhs);
+    }
+
+    private static Int9N multiplyNttForward(Int9N lhs, Int9N rhs) {
+        if (lhs.isZero() || rhs.isZero()) {
+            // don't reuse references b/c of mutability!
+            return Constants.ZERO();
         }
-        return parallelMultiplyKaratsubaForward(0, lhs, rhs, threshold, maxDepth, pool).multiplySign(lhs, rhs);
+        int[] result = multiplyNttImpl(lhs.data, lhs.offset, lhs.length, rhs.data, rhs.offset, rhs.length);
+        if (result == null) {
+            var tuning = tuning();
+            return multiplySubquadraticForward(lhs, rhs, tuning.karatsubaThreshold, tuning.toomCook3Threshold);
+        }
+        return new Int9N(result).canonicalize();
     }
 
-    private static Int9N parallelMultiplyKaratsubaForward(int depth, Int9N lhs, Int9N rhs, int threshold, int maxDepth, ForkJoinPool pool) {
-        if (lhs.length <= threshold || rhs.length <= threshold) {
-            return multiplySimpleForward(lhs, rhs);
-        } else if (depth >= maxDepth) {
-            return multiplyKaratsubaImpl(lhs, rhs, threshold);
+    private static int[] multiplyNttImpl(
+            int[] lhs, int lhsOffset, int lhsLength,
+            int[] rhs, int rhsOffset, int rhsLength) {
+
+        int lhsSize = lhsOffset + lhsLength;
+        int rhsSize = rhsOffset + rhsLength;
+        int shift = 1;
+
+        // fix coordinates for "trailingZeroesForm"
+        if (lhsSize > lhs.length) {
+            shift += lhsSize - lhs.length;
+            lhsSize = lhs.length;
+        }
+        if (rhsSize > rhs.length) {
+            shift += rhsSize - rhs.length;
+            rhsSize = rhs.length;
+        }
+        long scratchLength = multiplyNttScratchLength(lhsSize - lhsOffset, rhsSize - rhsOffset);
+        if (scratchLength < 0) {
+            return null; // too long for the transform
+        }
+        boolean counting = stats;
+        long start = counting ? System.nanoTime() : 0;
+        int[] result = new int[lhsLength + rhsLength];
+        var offHeap = offHeapMultiply ? OffHeap.stage(lhs, lhsOffset, lhsSize - lhsOffset, rhs, rhsOffset, rhsSize - rhsOffset, scratchLength) : null;
+        if (offHeap != null) {
+            multiplyNttDirectCore(offHeap.buffer, offHeap.resultIndex, 0, offHeap.lhsLength, offHeap.rhsIndex, offHeap.rhsLength, offHeap.scratchIndex);
+            offHeap.copyProduct(result, result.length, shift);
         } else {
-            return parallelMultiplyKaratsubaImpl(depth + 1, lhs, rhs, threshold, maxDepth, pool);
+            int[] scratch = ScratchArena.scratch(scratchLength);
+            multiplyNttCore(result, result.length, shift, lhs, lhsOffset, lhsSize - 1, rhs, rhsOffset, rhsSize - 1, scratch);
         }
+        if (counting) {
+            Stats.record(Stats.Kind.NTT, lhsLength, rhsLength, start);
+        }
+        return result;
     }
 
-    private static Int9N parallelMultiplyKaratsubaImpl(int depth, Int9N lhs, Int9N rhs, int threshold, int maxDepth, ForkJoinPool pool) {
-        assert threshold >= 1;
-        assert !(lhs.length == 1 && rhs.length == 1); // too low threshold
-        assert maxDepth >= 1;
-        assert depth <= maxDepth;
+    private static native long multiplyNttScratchLength(int lhsLength, int rhsLength);
 
-        int n = Math.max(lhs.length, rhs.length);
-        var a = lhs.leftPart(n);
-        var b = lhs.rightPart(n);
-        var c = rhs.leftPart(n);
-        var d = rhs.rightPart(n);
+    private static native void multiplyNttCore(
+            int[] result, int resultLength, int shift,
+            int[] lhs, int lhsOffset, int lhsMax,
+            int[] rhs, int rhsOffset, int rhsMax,
+            int[] scratch);
 
-        var _ac = submit(pool, () -> parallelMultiplyKaratsubaForward(depth, a, c, threshold, maxDepth, pool));
-        var _bd = submit(pool, () -> parallelMultiplyKaratsubaForward(depth, b, d, threshold, maxDepth, pool));
-        var _middle = submit(pool, () -> parallelMultiplyKaratsubaForward(
-                depth,
-                addAbs(a, b),
-                addAbs(c, d),
-                threshold,
-                maxDepth,
-                pool
-        ));
-        var ac = _ac.join();
-        var bd = _bd.join();
-        var middle = _middle.join();
+    private static native void multiplyNttDirectCore(
+            ByteBuffer buffer, int resultIndex,
+            int lhsIndex, int lhsLength,
+            int rhsIndex, int rhsLength,
+            int scratchIndex);
 
-        /*
+    /*
+     * The native code pins Java arrays with GetPrimitiveArrayCritical(), which holds off GC
+     * until the call returns. When enabled, the Karatsuba/Toom-Cook-3 and NTT multiplications
+     * copy their operands to a direct buffer instead (one per thread, kept up to 16 MB, see OffHeap.buffer()),
+     * and the native code runs on that, without a critical section.
+     */
+    private static volatile boolean offHeapMultiply;
+
+    public static void setOffHeapMultiply(boolean enabled) {
+        offHeapMultiply = enabled;
+    }
+
+    /*
+     * Multiplications and divisions allocate their temporaries per call: the scratch array of the
+     * native cores, and, in parallelMultiplyKaratsuba(), the sums and products of every node.
+     * When enabled, each thread keeps its scratch array for the next call instead (it only grows),
+     * and parallelMultiplyKaratsuba() runs in a single workspace, sized up front.
+     */
+    private static volatile boolean scratchArena;
+
+    public static void setScratchArena(boolean enabled) {
+        scratchArena = enabled;
+    }
+
+    /*
+     * When enabled, every multiplication kernel call is counted, timed and binned by size into the
+     * calling thread's Stats, see Stats.snapshot(), and the Stats MBean is registered.
+     * Off by default, unless the system property "philippag.compint.stats" is "true".
+     */
+    private static volatile boolean stats;
+
+    static {
+        if (Boolean.getBoolean(STATS_PROPERTY)) {
+            setStats(true);
+        }
+    }
+
+    public static void setStats(boolean enabled) {
+        if (enabled) {
+            Stats.registerMBean();
+        }
+        stats = enabled;
+    }
+
+    // lhs and rhs are the same number, because they are views of the same limbs
+    private static boolean isSameView(Int9N lhs, Int9N rhs) {
+        return lhs.data == rhs.data && lhs.offset == rhs.offset && lhs.length == rhs.length;
+    }
+
+    public static Int9N parallelMultiplyKaratsuba(Int9N lhs, Int9N rhs, ForkJoinPool pool) {
+        var tuning = tuning();
+        return parallelMultiplyKaratsuba(lhs, rhs, tuning.karatsubaThreshold, tuning.parallelThreshold, tuning.maxDepth, pool);
+    }
+
+    public static Int9N parallelMultiplyKaratsuba(Int9N lhs, Int9N rhs, int threshold, int maxDepth, ForkJoinPool pool) {
+        return parallelMultiplyKaratsuba(lhs, rhs, threshold, threshold, maxDepth, pool);
+    }
+
+    /*
+     * Operands longer than `parallelThreshold` are split into three sub-products,
+     * two of which are forked while the current task computes the third one,
+     * up to `maxDepth` levels. Shorter operands are multiplied sequentially,
+     * so a task always has enough work to be worth its overhead.
+     */
+    public static Int9N parallelMultiplyKaratsuba(Int9N lhs, Int9N rhs, int threshold, int parallelThreshold, int maxDepth, ForkJoinPool pool) {
+        if (threshold < 1) {
+            throw new IllegalArgumentException("Illegal threshold: " + threshold);
+        }
+        if (parallelThreshold < threshold) {
+            throw new IllegalArgumentException("Illegal parallel threshold: " + parallelThreshold);
+        }
+        if (maxDepth < 1) {
+            throw new IllegalArgumentException("Illegal maxDepth: " + maxDepth);
+        }
+        boolean counting = stats;
+        long start = counting ? System.nanoTime() : 0;
+        Int9N result;
+        if (scratchArena) {
+            result = parallelMultiplyKaratsubaArena(lhs, rhs, threshold, parallelThreshold, maxDepth, pool);
+        } else {
+            result = pool.invoke(task(() -> parallelMultiplyKaratsubaForward(0, lhs, rhs, threshold, parallelThreshold, maxDepth)));
+        }
+        if (counting) {
+            Stats.record(Stats.Kind.PARALLEL, lhs.length, rhs.length, start);
+        }
+        return result.multiplySign(lhs, rhs);
+    }
+
+    private static Int9N parallelMultiplyKaratsubaForward(int depth, Int9N lhs, Int9N rhs, int threshold, int parallelThreshold, int maxDepth) {
+        if (lhs.length <= threshold || rhs.length <= threshold) {
+            return multiplySimpleForward(lhs, rhs);
+        } else if (depth >= maxDepth || lhs.length <= parallelThreshold || rhs.length <= parallelThreshold) {
+            return multiplySubquadraticImpl(lhs, rhs, threshold, Math.max(threshold, tuning().toomCook3Threshold));
+        } else if (Math.max(lhs.length, rhs.length) >= 2 * Math.min(lhs.length, rhs.length)) {
+            return parallelMultiplyUnbalanced(depth + 1, lhs, rhs, threshold, parallelThreshold, maxDepth);
+        } else {
+            return parallelMultiplyKaratsubaImpl(depth + 1, lhs, rhs, threshold, parallelThreshold, maxDepth);
+        }
+    }
+
+    /*
+     * One operand is at least twice as long as the other: a Karatsuba split at half of the longer one
+     * would leave the shorter one without a high part, and two of the three sub-products on zero.
+     * So both halves of the longer operand are multiplied with the shorter one instead, in parallel,
+     * until the pieces are balanced (like mul_chunks() in int9.c, which cuts them all at once).
+     */
+    private static Int9N parallelMultiplyUnbalanced(int depth, Int9N lhs, Int9N rhs, int threshold, int parallelThreshold, int maxDepth) {
+        var longer = lhs.length >= rhs.length ? lhs : rhs;
+        var shorter = longer == lhs ? rhs : lhs;
+        int n = longer.length;
+        var high = longer.leftPart(n);
+        var low = longer.rightPart(n);
+
+        var _high = task(() -> parallelMultiplyKaratsubaForward(depth, high, shorter, threshold, parallelThreshold, maxDepth)).fork();
+        var lowProduct = parallelMultiplyKaratsubaForward(depth, low, shorter, threshold, parallelThreshold, maxDepth);
+        var highProduct = _high.join();
+
+        var result = new Int9N(new int[lhs.length + rhs.length]);
+        result.addInPlaceAbsLongerEqual(highProduct.shiftLeft(n >> 1));
+        result.addInPlaceAbsLongerEqual(lowProduct);
+        return result.canonicalize();
+    }
+
+    // runs within a task of the pool, see task()
+    private static Int9N parallelMultiplyKaratsubaImpl(int depth, Int9N lhs, Int9N rhs, int threshold, int parallelThreshold, int maxDepth) {
+        assert threshold >= 1;
+        assert !(lhs.length == 1 && rhs.length == 1); // too low threshold
+        assert maxDepth >= 1;
+        assert depth <= maxDepth;
+
+        int n = Math.max(lhs.length, rhs.length);
+        var a = lhs.leftPart(n);
+        var b = lhs.rightPart(n);
+        var c = rhs.leftPart(n);
+        var d = rhs.rightPart(n);
+
+        var _ac = task(() -> parallelMultiplyKaratsubaForward(depth, a, c, threshold, parallelThreshold, maxDepth)).fork();
+        var _bd = task(() -> parallelMultiplyKaratsubaForward(depth, b, d, threshold, parallelThreshold, maxDepth)).fork();
+        var ab = addAbs(a, b);
+        // for squares the sum is passed twice, so the leaves can square it
+        var cd = isSameView(lhs, rhs) ? ab : addAbs(c, d);
+        var middle = parallelMultiplyKaratsubaForward(depth, ab, cd, threshold, parallelThreshold, maxDepth);
+        // joined in reverse order, so a task which wasn't stolen is taken back and run right here
+        var bd = _bd.join();
+        var ac = _ac.join();
+
+        /*
          * We use the distributive law here:
          * `middle` is currently `(a + b) * (c + d)`,
          * which distributes to
@@ -1620,255 +2904,1518 @@ private static Int9N parallelMultiplyKaratsubaImpl(int depth, Int9N lhs, Int9N r
         return result.canonicalize();
     }
 
-    @SuppressWarnings("serial")
-    private static ForkJoinTask<Int9N> submit(ForkJoinPool pool, Supplier<Int9N> fn) {
-        return pool.submit(new RecursiveTask<Int9N>() {
+    private static Int9N parallelMultiplyKaratsubaArena(Int9N lhs, Int9N rhs, int threshold, int parallelThreshold, int maxDepth, ForkJoinPool pool) {
+        if (lhs.length <= threshold || rhs.length <= threshold) {
+            return multiplySimpleForward(lhs, rhs);
+        }
+        int lhsLength = lhs.extent() - lhs.offset; // without "trailingZeroesForm"
+        int rhsLength = rhs.extent() - rhs.offset;
+        long workspaceLength = workspaceLength(Math.max(lhsLength, rhsLength), 0, parallelThreshold, maxDepth);
+        if (workspaceLength > Integer.MAX_VALUE - 8) {
+            return pool.invoke(task(() -> parallelMultiplyKaratsubaForward(0, lhs, rhs, threshold, parallelThreshold, maxDepth)));
+        }
+        int[] result = new int[lhs.length + rhs.length];
+        int[] workspace = new int[(int) workspaceLength];
+        pool.invoke(ForkJoinTask.adapt(() -> parallelMultiplyKaratsubaArena(0, lhs.data, lhs.offset, lhsLength, rhs.data, rhs.offset, rhsLength,
+                result, 0, workspace, 0, threshold, parallelThreshold, maxDepth)));
+        return new Int9N(result).canonicalize();
+    }
+
+    // the workspace needed by a node of parallelMultiplyKaratsubaArena() with operands of at most n limbs, and by its children
+    private static long workspaceLength(int n, int depth, int parallelThreshold, int maxDepth) {
+        if (n <= parallelThreshold || depth >= maxDepth) {
+            return 0;
+        }
+        int m = ((n + 1) >> 1) + 1; // limbs of a + b
+        long children = m < n ? workspaceLength(m, depth + 1, parallelThreshold, maxDepth) : Long.MAX_VALUE;
+        return children > Integer.MAX_VALUE ? children : 4L * m + 3 * children; // saturates, for huge depths
+    }
+
+    /*
+     * Same as parallelMultiplyKaratsubaImpl(), but without allocation: x * y goes to dst[dstOffset, dstOffset + xLength + yLength).
+     * ac and bd are the upper and lower part of that already, so they go there directly.
+     * The sums a + b and c + d, and their product are placed at workspace[workspaceOffset..],
+     * followed by the workspaces of the three children, as those run at the same time.
+     */
+    private static void parallelMultiplyKaratsubaArena(int depth,
+            int[] x, int xOffset, int xLength,
+            int[] y, int yOffset, int yLength,
+            int[] dst, int dstOffset, int[] workspace, int workspaceOffset,
+            int threshold, int parallelThreshold, int maxDepth) {
+
+        int n = Math.max(xLength, yLength);
+        int half = n >> 1;
+        int productEnd = dstOffset + xLength + yLength;
+        if (xLength <= threshold || yLength <= threshold) {
+            Arrays.fill(dst, dstOffset, productEnd, 0);
+            if (xLength >= yLength) {
+                multiplyImpl(dst, productEnd, x, xOffset, xLength, y, yOffset, yLength);
+            } else {
+                multiplyImpl(dst, productEnd, y, yOffset, yLength, x, xOffset, xLength);
+            }
+            return;
+        }
+        if (depth >= maxDepth || xLength <= parallelThreshold || yLength <= parallelThreshold
+                || xLength <= half || yLength <= half) { // the native recursion also takes unbalanced operands
+            Arrays.fill(dst, dstOffset, productEnd, 0);
+            multiplySubquadraticImpl(dst, productEnd, x, xOffset, xLength, y, yOffset, yLength, threshold, Math.max(threshold, tuning().toomCook3Threshold));
+            return;
+        }
+
+        // x = a * BASE^half + b, y = c * BASE^half + d
+        int aLength = xLength - half;
+        int cLength = yLength - half;
+        int m = ((n + 1) >> 1) + 1;
+        int ab = workspaceOffset;
+        int cd = ab + m;
+        int middle = ab + 2 * m;
+        int child = ab + 4 * m;
+        int childLength = (int) workspaceLength(m, depth + 1, parallelThreshold, maxDepth);
+        int bd = dstOffset + aLength + cLength;
+
+        var _ac = ForkJoinTask.adapt(() -> parallelMultiplyKaratsubaArena(depth + 1, x, xOffset, aLength, y, yOffset, cLength,
+                dst, dstOffset, workspace, child, threshold, parallelThreshold, maxDepth)).fork();
+        var _bd = ForkJoinTask.adapt(() -> parallelMultiplyKaratsubaArena(depth + 1, x, xOffset + aLength, half, y, yOffset + cLength, half,
+                dst, bd, workspace, child + childLength, threshold, parallelThreshold, maxDepth)).fork();
+
+        addInto(workspace, ab, m, x, xOffset, aLength, x, xOffset + aLength, half);
+        // for squares the sum is passed twice, so the leaves can square it
+        boolean square = x == y && xOffset == yOffset && xLength == yLength;
+        if (!square) {
+            addInto(workspace, cd, m, y, yOffset, cLength, y, yOffset + cLength, half);
+        }
+        // without leading zeroes, so the children's operands get shorter
+        int abStart = firstNonZero(workspace, ab, ab + m);
+        int cdStart = square ? abStart : firstNonZero(workspace, cd, cd + m);
+        int abLength = ab + m - abStart;
+        int cdLength = (square ? ab : cd) + m - cdStart;
+        parallelMultiplyKaratsubaArena(depth + 1, workspace, abStart, abLength, workspace, cdStart, cdLength,
+                workspace, middle, workspace, child + 2 * childLength, threshold, parallelThreshold, maxDepth);
+        _bd.join();
+        _ac.join();
+
+        // see parallelMultiplyKaratsubaImpl(), all of it in place
+        var sum = new Int9N(workspace, middle, abLength + cdLength).canonicalize();
+        int acStart = firstNonZero(dst, dstOffset, bd);
+        int bdStart = firstNonZero(dst, bd, productEnd);
+        sum.subtractInPlaceAbsGreaterEqualCore(dst, acStart, bd - acStart);
+        sum.subtractInPlaceAbsGreaterEqualCore(dst, bdStart, productEnd - bdStart);
+        new Int9N(dst, dstOffset, xLength + yLength - half).addInPlaceAbsLongerEqualCore(workspace, sum.offset, sum.length);
+    }
+
+    // r[rOffset, rOffset + rLength) = a + b, where rLength > max(aLength, bLength)
+    private static void addInto(int[] r, int rOffset, int rLength, int[] a, int aOffset, int aLength, int[] b, int bOffset, int bLength) {
+        int accumulator = 0;
+        for (int i = rLength - 1, j = aLength - 1, k = bLength - 1; i >= 0; --i, --j, --k) {
+            accumulator = (j >= 0 ? a[aOffset + j] : 0) + (k >= 0 ? b[bOffset + k] : 0) + AddWithCarry.carry(accumulator);
+            r[rOffset + i] = AddWithCarry.value(accumulator);
+        }
+    }
+
+    // the index of the first non-zero limb in data[from, to), or to - 1 if all are zero
+    private static int firstNonZero(int[] data, int from, int to) {
+        int i = from;
+        while (i < to - 1 && data[i] == 0) {
+            i++;
+        }
+        return i;
+    }
+
+    @SuppressWarnings("serial")
+    private static RecursiveTask<Int9N> task(Supplier<Int9N> fn) {
+        return new RecursiveTask<Int9N>() {
+
+            @Override
+            protected Int9N compute() {
+                return fn.get();
+            }
+        };
+    }
+
+    public static Int9N parallelMultiplyNative(Int9N lhs, Int9N rhs, int threads) {
+        var tuning = tuning();
+        return parallelMultiplyNative(lhs, rhs, tuning.karatsubaThreshold, tuning.parallelThreshold, threads);
+    }
+
+    /*
+     * Splits the product into at least 2 * `threads` sub-products (by Karatsuba, or into chunks of
+     * the longer operand if the other one is much shorter), down to `parallelThreshold` limbs,
+     * and multiplies them on `threads` native threads, see par_mul_big_endian() in int9.c.
+     * Like with setOffHeapMultiply(), the operands are copied to a direct buffer,
+     * so GC is not blocked meanwhile; if they don't fit, this falls back to parallelMultiplyKaratsuba().
+     */
+    public static Int9N parallelMultiplyNative(Int9N lhs, Int9N rhs, int threshold, int parallelThreshold, int threads) {
+        if (threshold < 1) {
+            throw new IllegalArgumentException("Illegal threshold: " + threshold);
+        }
+        if (parallelThreshold < threshold) {
+            throw new IllegalArgumentException("Illegal parallel threshold: " + parallelThreshold);
+        }
+        if (threads < 1) {
+            throw new IllegalArgumentException("Illegal thread count: " + threads);
+        }
+        if (lhs.length <= threshold || rhs.length <= threshold) {
+            return multiplySimpleForward(lhs, rhs).multiplySign(lhs, rhs);
+        }
+        int[] result = parallelMultiplyNativeImpl(lhs.data, lhs.offset, lhs.length, rhs.data, rhs.offset, rhs.length,
+                threshold, parallelThreshold, threads);
+        if (result == null) {
+            return parallelMultiplyKaratsuba(lhs, rhs, threshold, parallelThreshold, Integer.MAX_VALUE, ForkJoinPool.commonPool());
+        }
+        return new Int9N(result).canonicalize().multiplySign(lhs, rhs);
+    }
+
+    private static int[] parallelMultiplyNativeImpl(
+            int[] lhs, int lhsOffset, int lhsLength,
+            int[] rhs, int rhsOffset, int rhsLength,
+            int threshold, int parallelThreshold, int threads) {
+
+        int lhsSize = lhsOffset + lhsLength;
+        int rhsSize = rhsOffset + rhsLength;
+        int shift = 1;
+
+        // fix coordinates for "trailingZeroesForm"
+        if (lhsSize > lhs.length) {
+            shift += lhsSize - lhs.length;
+            lhsSize = lhs.length;
+        }
+        if (rhsSize > rhs.length) {
+            shift += rhsSize - rhs.length;
+            rhsSize = rhs.length;
+        }
+        int toomCook3Threshold = Math.max(threshold, tuning().toomCook3Threshold);
+        long scratchLength = multiplyParallelScratchLength(lhsSize - lhsOffset, rhsSize - rhsOffset, threads,
+                parallelThreshold, threshold, toomCook3Threshold);
+        var offHeap = OffHeap.stage(lhs, lhsOffset, lhsSize - lhsOffset, rhs, rhsOffset, rhsSize - rhsOffset, scratchLength);
+        if (offHeap == null) {
+            return null;
+        }
+        boolean counting = stats;
+        long start = counting ? System.nanoTime() : 0;
+        multiplyParallelDirectCore(offHeap.buffer, offHeap.resultIndex, 0, offHeap.lhsLength, offHeap.rhsIndex, offHeap.rhsLength,
+                offHeap.scratchIndex, threads, parallelThreshold, threshold, toomCook3Threshold);
+        if (counting) {
+            Stats.record(Stats.Kind.PARALLEL_NATIVE, lhsLength, rhsLength, start);
+        }
+        int[] result = new int[lhsLength + rhsLength];
+        offHeap.copyProduct(result, result.length, shift);
+        return result;
+    }
+
+    private static native long multiplyParallelScratchLength(
+            int lhsLength, int rhsLength, int threads,
+            int parallelThreshold, int karatsubaThreshold, int toomCook3Threshold);
+
+    private static native void multiplyParallelDirectCore(
+            ByteBuffer buffer, int resultIndex,
+            int lhsIndex, int lhsLength,
+            int rhsIndex, int rhsLength,
+            int scratchIndex, int threads,
+            int parallelThreshold, int karatsubaThreshold, int toomCook3Threshold);
+
+    /*
+     * CharSequence API
+     */
+
+    @Override
+    public int length() {
+        return (negative ? 1 : 0) + countDigits();
+    }
+
+    // random access to a digit w/o needing to materialize a string
+    // this is optimized to not have any divisions.
+    // Note: a solution with cached segments of 9-digit-substring was tried
+    // and actually performed worse than this...
+    @Override
+    public char charAt(int index) {
+        if (negative) {
+            if (index == 0) {
+                return '-';
+            }
+            index--;
+        }
+        // correct for variable length of first element in data[]
+        index += SIZE - firstDigitLength();
+
+        int div9 = DivMulTable.div9(index);
+        int idx = offset + div9;
+        return idx < data.length ? IntegerFormat.at(data[idx], DivMulTable.mod9(div9, index)) : '0';
+    }
+
+    @Override
+    public Int9N subSequence(int start, int end) {
+        int sign = negative ? 1 : 0;
+        if (0 <= start && start < end && end <= length() && end - start > SIZE) {
+            // the digits in bulk, then parsed natively
+            byte[] ascii = new byte[end - start];
+            if (start < sign) {
+                ascii[0] = '-';
+                getDigits(0, ascii, 1, end - 1);
+            } else {
+                getDigits(start - sign, ascii, 0, end - start);
+            }
+            return fromString(ascii, 0, ascii.length);
+        }
+        // we must not return `this` b/c of mutability
+        return fromString(this, start, end);
+    }
+
+    private static class Calc {
+
+        static int bitLength(long w) {
+            return 64 - Long.numberOfLeadingZeros(w);
+        }
+
+        static boolean isPowerOfTwo(long w) {
+            assert w > 0;
+            return (w & (w - 1)) == 0;
+        }
+
+        static int lengthOf(long n) {
+            assert n >= 0;
+            return n < BASE1 ? 1 : n < BASE2 ? 2 : 3;
+        }
+
+        static int lengthForDigits(int digits) {
+            int div9 = DivMulTable.div9(digits);
+            int mod9 = DivMulTable.mod9(div9, digits);
+            return div9 + (mod9 == 0 ? 0 : 1);
+        }
+
+        static int addInPlaceCapacity(int lhs, int rhs) {
+            return lhs > rhs ? 1 : 1 + rhs - lhs; // always need one more space for 999_999_999 + 1 case!
+        }
+
+        static int subtractInPlaceCapacity(int lhs, int rhs) {
+            return lhs > rhs ? 0 : rhs - lhs;
+        }
+    }
+
+    private static class AddWithCarry {
+
+        static int value(int accumulator) {
+            return accumulator < BASE ? accumulator : accumulator - BASE;
+        }
+
+        static int carry(int accumulator) {
+            return accumulator < BASE ? 0 : 1;
+        }
+    }
+
+    private static class SubtractWithCarry {
+
+        static int value(int accumulator) {
+            return accumulator >= 0 ? accumulator : accumulator + BASE;
+        }
+
+        static int carry(int accumulator) {
+            return accumulator >= 0 ? 0 : -1;
+        }
+    }
+
+    private static class SubtractWithCarryComplement {
+
+        static int value(int accumulator) {
+            return BASE - (accumulator > 0 ? accumulator : accumulator + BASE);
+        }
+
+        static int carry(int accumulator) {
+            return accumulator <= 0 ? 0 : 1;
+        }
+    }
+
+    // the bytes [0, limit) of a buffer as Latin-1 characters, which fromString() parses natively
+    private static final class Latin1Chars implements CharSequence {
+
+        final ByteBuffer bytes;
+
+        Latin1Chars(ByteBuffer bytes) {
+            this.bytes = bytes;
+        }
+
+        @Override
+        public int length() {
+            return bytes.limit();
+        }
+
+        @Override
+        public char charAt(int index) {
+            return (char) (bytes.get(index) & 0xFF);
+        }
+
+        @Override
+        public CharSequence subSequence(int start, int end) {
+            return StandardCharsets.ISO_8859_1.decode(bytes.slice(start, end - start)).toString();
+        }
+
+        @Override
+        public String toString() {
+            return subSequence(0, length()).toString();
+        }
+    }
+
+    private static class IntegerFormat {
+
+        static int parse(CharSequence str, int fromIndex, int toIndex) {
+            int result = 0;
+            assert fromIndex < toIndex;
+            assert toIndex - fromIndex <= SIZE; // need no overflow protection if this holds
+
+            for (int i = fromIndex; i < toIndex; i++) {
+                char c = str.charAt(i);
+                if (!('0' <= c && c <= '9')) {
+                    throw new NumberFormatException("Non-digit character '" + c + "' at index " + i);
+                }
+                result = DivMulTable.mul10(result) + c - '0';
+            }
+
+            return result;
+        }
+
+        // equivalent to String.valueOf(digit).charAt(idx)
+        static char at(int digit, int idx) {
+            assert 0 <= idx && idx < SIZE : idx;
+            return (char) (DivMulTable.mod10(DivMulTable.divPower10(digit, idx)) + '0');
+        }
+
+        static void format(byte[] dest, int n, int left, int right) {
+            for (int i = right - 1; i >= left; --i) {
+                if (n == 0) {
+                    dest[i] = '0';
+                } else {
+                    int div10 = DivMulTable.div10(n);
+                    dest[i] = (byte) (DivMulTable.mod10(div10, n) + '0');
+                    n = div10;
+                }
+            }
+        }
+
+        static int length(int n) {
+            assert n < BASE;
+            return n < 100_000 ?         n <        100 ? n <        10 ? 1 : 2 : n <       1_000 ? 3
+                 : n <  10_000 ? 4 : 5 : n < 10_000_000 ? n < 1_000_000 ? 6 : 7 : n < 100_000_000 ? 8 : 9;
+        }
+    }
+
+    /**
+     * Collection of "magic numbers" to replace divisions with multiplications.
+     * It's quite surprising that this actually helps performance, i.e.
+     * the JIT doesn't seem to do this, or do it well.
+     * The "magic numbers" are actually -(modular inverses)- reciprocal numbers.
+     * They were found using Compiler Explorer.
+     */
+    private static class DivMulTable {
+
+        private static final int[] MOD_INV = { // MOD_INV[i] == (1 << SHR[i]) / POWERS_OF_TEN[i] + 1; // except for last one
+        /*1E8*/ 0x55e63b89,
+                0x6b5fca6b,
+                0x431bde83,
+                0x14f8b589,
+                0x68db8bad,
+                0x10624dd3,
+                0x51eb851f,
+                0x66666667,
+        /*1E0*/ 1,
+        };
+
+        private static final int[] SHR = {
+        /*1E8*/ 57,
+                54,
+                50,
+                45,
+                44,
+                38,
+                37,
+                34,
+        /*1E0*/ 0,
+        };
+
+        private static final int[] POWERS_OF_TEN = {
+            100_000_000, 10_000_000, 1_000_000, 100_000, 10_000, 1_000, 100, 10, 1,
+        };
+
+        // equivalent to input / POWERS_OF_TEN[idx] with POWERS_OF_TEN = { 1E8 .. 1E0 }
+        // Note: replacing the arrays with a switch seems to perform worse.
+        static int divPower10(long input, int idx) {
+            assert input >> 31 == 0; // so we don't need the subtraction part
+            return (int) ((input * MOD_INV[idx]) >> SHR[idx]);
+        }
+
+        static int mulPower10(int input, int idx) {
+            return input * POWERS_OF_TEN[idx];
+        }
+
+        static int div10(int input) {
+            assert input >> 31 == 0; // so we don't need the subtraction part
+            return (int) ((input * 0x66666667L) >> 34);
+        }
+
+        static int mod10(int input) {
+            return mod10(div10(input), input);
+        }
+
+        static int mod10(int div10, int input) {
+            return input - mul10(div10);
+        }
+
+        static int mul10(int input) {
+            return (input + (input << 2)) << 1;
+        }
+
+        static long div3(long input) {
+            return (input * 0xAAAAAAABL) >> 33;
+        }
+
+        static long mod3(long div3, long input) {
+            return input - mul3(div3);
+        }
+
+        static long mul3(long input) {
+            return input + (input << 1);
+        }
+
+        static int div9(int input) {
+            assert input >> 31 == 0; // so we don't need the subtraction part
+            return (int) ((input * 0x38e38e39L) >> 33);
+        }
+
+        static int mod9(int div9, int input) {
+            return input - mul9(div9);
+        }
+
+        static int mul9(int input) {
+            return (input << 3) + input;
+        }
+    }
+
+    /*
+     * binary(i) = 2^(32 * 2^i) and decimal(i) = BASE^(2^i), each squared from the previous one on first use.
+     * Never return to user!
+     */
+    private static class RadixPowers {
+
+        static final BigInteger BASE_SQUARED = BigInteger.valueOf(BASE2);
+
+        private static Int9N[] binary = { fromLong(1L << 32) };
+        private static BigInteger[] decimal = { BigInteger.valueOf(BASE) };
+
+        static synchronized Int9N binary(int i) {
+            while (binary.length <= i) {
+                var last = binary[binary.length - 1];
+                binary = Arrays.copyOf(binary, binary.length + 1);
+                binary[binary.length - 1] = last.multiply(last);
+            }
+            return binary[i];
+        }
+
+        static synchronized BigInteger decimal(int i) {
+            while (decimal.length <= i) {
+                var last = decimal[decimal.length - 1];
+                decimal = Arrays.copyOf(decimal, decimal.length + 1);
+                decimal[decimal.length - 1] = last.multiply(last);
+            }
+            return decimal[i];
+        }
+    }
+
+    /*
+     * Crossover points between the multiplication algorithms, in limbs, and the recursion depth
+     * up to which parallelMultiplyKaratsuba() forks tasks. They depend on the CPU, so besides the
+     * DEFAULT ones, which fit a recent x86-64, calibrate() measures them on the machine we run on.
+     */
+    public static final class Tuning {
+
+        public static final Tuning DEFAULT = new Tuning(KARATSUBA_THRESHOLD, TOOM_COOK_3_THRESHOLD, NTT_THRESHOLD, PARALLEL_THRESHOLD, Integer.MAX_VALUE);
+
+
+        public final int karatsubaThreshold;
+        public final int toomCook3Threshold;
+        public final int nttThreshold;
+        public final int parallelThreshold;
+        public final int maxDepth;
+
+        public Tuning(int karatsubaThreshold, int toomCook3Threshold, int nttThreshold, int parallelThreshold, int maxDepth) {
+            if (karatsubaThreshold < 1) {
+                throw new IllegalArgumentException("Illegal threshold: " + karatsubaThreshold);
+            }
+            if (toomCook3Threshold < karatsubaThreshold) {
+                throw new IllegalArgumentException("Illegal Toom-Cook-3 threshold: " + toomCook3Threshold);
+            }
+            if (nttThreshold < 1) {
+                throw new IllegalArgumentException("Illegal NTT threshold: " + nttThreshold);
+            }
+            if (parallelThreshold < karatsubaThreshold) {
+                throw new IllegalArgumentException("Illegal parallel threshold: " + parallelThreshold);
+            }
+            if (maxDepth < 1) {
+                throw new IllegalArgumentException("Illegal max depth: " + maxDepth);
+            }
+            this.karatsubaThreshold = karatsubaThreshold;
+            this.toomCook3Threshold = toomCook3Threshold;
+            this.nttThreshold = nttThreshold;
+            this.parallelThreshold = parallelThreshold;
+            this.maxDepth = maxDepth;
+        }
+
+        /*
+         * Times the algorithms against each other on random operands, which takes a few seconds:
+         * each threshold is the fastest candidate for a product a few times longer than it,
+         * the NTT one the shortest length from which on the transform beats Toom-Cook-3.
+         * Without more than one processor, the parallel settings are the DEFAULT ones.
+         */
+        public static Tuning calibrate() {
+            var rnd = Calibration.random();
+
+            var x = random(rnd, 640);
+            var y = random(rnd, 640);
+            int karatsuba = Calibration.fastest(new int[] { 10, 20, 30, 40, 60, 80, 120, 160 },
+                    k -> multiplyToomCook3(x, y, k, Integer.MAX_VALUE));
+
+            var u = random(rnd, 3_000);
+            var v = random(rnd, 3_000);
+            int toomCook3 = Calibration.fastest(new int[] { 120, 160, 240, 320, 480, 640 },
+                    t -> multiplyToomCook3(u, v, karatsuba, Math.max(t, karatsuba)));
+
+            int ntt = Integer.MAX_VALUE;
+            for (int n : new int[] { 64, 96, 128, 192, 256, 320, 448, 640, 896, 1_280, 1_792, 2_560 }) {
+                var a = random(rnd, n);
+                var b = random(rnd, n);
+                if (Calibration.time(() -> multiplyNtt(a, b)) < Calibration.time(() -> multiplyToomCook3(a, b, karatsuba, toomCook3))) {
+                    ntt = n - 1; // the NTT is used above the threshold
+                    break;
+                }
+            }
+
+            int parallel = Math.max(PARALLEL_THRESHOLD, karatsuba);
+            int maxDepth = DEFAULT.maxDepth;
+            var pool = ForkJoinPool.commonPool();
+            if (pool.getParallelism() > 1) {
+                var p = random(rnd, 20_000);
+                var q = random(rnd, 20_000);
+                parallel = Calibration.fastest(new int[] { 250, 500, 1_000, 2_000, 4_000 },
+                        t -> parallelMultiplyKaratsuba(p, q, karatsuba, Math.max(t, karatsuba), Integer.MAX_VALUE, pool));
+                int parallelThreshold = parallel;
+                maxDepth = Calibration.fastest(new int[] { 2, 4, 6, 8, Integer.MAX_VALUE },
+                        d -> parallelMultiplyKaratsuba(p, q, karatsuba, Math.max(parallelThreshold, karatsuba), d, pool));
+            }
+            return new Tuning(karatsuba, Math.max(toomCook3, karatsuba), ntt, Math.max(parallel, karatsuba), maxDepth);
+        }
+
+        /*
+         * The tuning cached in the file "int9.tuning" next to the native library, if that was
+         * calibrated on the same kind of machine; otherwise calibrate() runs and its result is cached.
+         * Without a native library file (or if it can't be written), nothing is cached.
+         */
+        public static Tuning calibrated() {
+            var library = NativeLibLoader.library;
+            var file = library == null ? null : new File(library.getParentFile(), TUNING_FILE);
+            if (file != null && file.exists()) {
+                try {
+                    var cached = load(file);
+                    if (cached != null) {
+                        return cached;
+                    }
+                    System.err.printf("WARN [%s]: Tuning in '%s' is from another machine, calibrating again\n", Int9N.class.getName(), file);
+                } catch (IOException | IllegalArgumentException e) {
+                    System.err.printf("WARN [%s]: Could not load tuning from '%s', calibrating again: %s\n", Int9N.class.getName(), file, e);
+                }
+            }
+            var tuning = calibrate();
+            if (file != null) {
+                try {
+                    tuning.store(file);
+                } catch (IOException e) {
+                    System.err.printf("WARN [%s]: Could not store tuning in '%s': %s\n", Int9N.class.getName(), file, e);
+                }
+            }
+            return tuning;
+        }
+
+        // null if the file was written on another kind of machine
+        private static Tuning load(File file) throws IOException {
+            var properties = new Properties();
+            try (var in = Files.newBufferedReader(file.toPath(), StandardCharsets.ISO_8859_1)) {
+                properties.load(in);
+            }
+            if (!machine().equals(properties.getProperty("machine"))) {
+                return null;
+            }
+            return new Tuning(
+                    Integer.parseInt(properties.getProperty("karatsubaThreshold")),
+                    Integer.parseInt(properties.getProperty("toomCook3Threshold")),
+                    Integer.parseInt(properties.getProperty("nttThreshold")),
+                    Integer.parseInt(properties.getProperty("parallelThreshold")),
+                    Integer.parseInt(properties.getProperty("maxDepth")));
+        }
+
+        private void store(File file) throws IOException {
+            var properties = new Properties();
+            properties.setProperty("machine", machine());
+            properties.setProperty("karatsubaThreshold", Integer.toString(karatsubaThreshold));
+            properties.setProperty("toomCook3Threshold", Integer.toString(toomCook3Threshold));
+            properties.setProperty("nttThreshold", Integer.toString(nttThreshold));
+            properties.setProperty("parallelThreshold", Integer.toString(parallelThreshold));
+            properties.setProperty("maxDepth", Integer.toString(maxDepth));
+            try (var out = Files.newBufferedWriter(file.toPath(), StandardCharsets.ISO_8859_1)) {
+                properties.store(out, "calibrated by " + Int9N.class.getName());
+            }
+        }
+
+        // architecture, processor count and (on Linux) the CPU model, a tuning is only valid on the same
+        private static String machine() {
+            String model = "";
+            try (var lines = Files.lines(new File("/proc/cpuinfo").toPath())) {
+                model = lines.filter(line -> line.startsWith("model name")).findFirst().orElse("");
+            } catch (IOException | UncheckedIOException e) {
+                // not on Linux, architecture and processor count have to do
+            }
+            model = model.substring(model.indexOf(':') + 1).trim();
+            return System.getProperty("os.arch") + "/" + Runtime.getRuntime().availableProcessors() + "/" + model;
+        }
+
+        private static Int9N random(Random rnd, int length) {
+            int[] data = new int[length];
+            for (int i = 0; i < length; i++) {
+                data[i] = rnd.nextInt(BASE);
+            }
+            data[0] = 1 + rnd.nextInt(BASE - 1);
+            return new Int9N(data);
+        }
+
+        @Override
+        public String toString() {
+            return "Tuning {karatsubaThreshold=" + karatsubaThreshold
+                    + ", toomCook3Threshold=" + toomCook3Threshold
+                    + ", nttThreshold=" + nttThreshold
+                    + ", parallelThreshold=" + parallelThreshold
+                    + ", maxDepth=" + maxDepth + "}";
+        }
+    }
+
+    private static native long modMultiplyScratchLength(int modulusLength, int windowBits, int karatsubaThreshold, int toomCook3Threshold);
+
+    private static native void modMultiplyCore(
+            int[] result, int[] lhs, int[] rhs,
+            int[] modulus, int inverse, int[] r2,
+            int[] scratch, int karatsubaThreshold, int toomCook3Threshold);
+
+    private static native void modPowCore(
+            int[] result, int[] base, byte[] exponent,
+            int[] modulus, int inverse, int[] r2, int windowBits,
+            int[] scratch, int karatsubaThreshold, int toomCook3Threshold);
+
+    /**
+     * Arithmetic modulo a fixed modulus, which must be positive and coprime to 10 (i.e. to the base 1E9).
+     * The constants of Montgomery multiplication are computed once, then every product is reduced
+     * natively in the same pass that computes it (see mod_mul() in int9.c), without any division,
+     * and modPow() runs all its steps in one native call.
+     * Operands may be any numbers, they are reduced first; results are in [0, modulus).
+     * modMul() takes a second Montgomery pass to get out of Montgomery form, and allocates its result;
+     * long chains of products should use Residue and modMulInPlace() instead, which do neither.
+     * Not thread-safe, as the context keeps the operand copies and the scratch space of the native code.
+     */
+    public static final class ModContext {
+
+        private final Int9N modulus;
+        private final int[] limbs; // little-endian, like all arrays passed to the native code here
+        private final int inverse; // -1 / modulus mod BASE
+        private final int[] r2; // BASE^(2 * limbs.length) mod modulus
+        private final int[] one; // 1, to multiply out of Montgomery form
+        private final int[] lhsLimbs;
+        private final int[] rhsLimbs;
+        private final int[] resultLimbs;
+        private int[] scratch; // only grows
+        private Tuning scratchTuning; // scratch is large enough for a product with these thresholds
+
+        public ModContext(Int9N modulus) {
+            int lowest = modulus.isZero() ? 0 : modulus.get(modulus.length - 1);
+            if (modulus.negative || lowest % 2 == 0 || lowest % 5 == 0) {
+                throw new IllegalArgumentException("Illegal modulus: must be positive and coprime to 10");
+            }
+            this.modulus = modulus.limbs(0, modulus.length);
+            int n = this.modulus.length;
+            limbs = littleEndian(this.modulus, new int[n]);
+            inverse = inverse(lowest);
+            r2 = littleEndian(Int9N.modulo(Constants.ONE().shiftLeft(2 * n), this.modulus), new int[n]);
+            one = new int[n];
+            one[0] = 1;
+            lhsLimbs = new int[n];
+            rhsLimbs = new int[n];
+            resultLimbs = new int[n];
+        }
+
+        /**
+         * A number x mod modulus in Montgomery form (x * BASE^n mod modulus, n being the modulus' length),
+         * made by toMontgomery() and turned back by fromMontgomery(). Products of residues stay in that
+         * form, so modMulInPlace() needs only one Montgomery pass, and no allocation.
+         */
+        public final class Residue {
+
+            private final int[] limbs = new int[ModContext.this.limbs.length]; // little-endian, below the modulus
+
+            private Residue() {
+            }
+
+            public Residue copy() {
+                var result = new Residue();
+                System.arraycopy(limbs, 0, result.limbs, 0, limbs.length);
+                return result;
+            }
+
+            private ModContext context() {
+                return ModContext.this;
+            }
+        }
+
+        public Int9N getModulus() {
+            return modulus.copy();
+        }
+
+        // x mod modulus, in [0, modulus)
+        public Int9N mod(Int9N x) {
+            var result = reduce(x);
+            // don't reuse references b/c of mutability!
+            return result == x ? x.copy() : result;
+        }
+
+        private Int9N reduce(Int9N x) {
+            if (!x.negative && x.compareToAbs(modulus) < 0) {
+                return x;
+            }
+            var result = Int9N.modulo(x, modulus);
+            return result.negative ? add(result, modulus) : result;
+        }
+
+        public Int9N modMul(Int9N lhs, Int9N rhs) {
+            littleEndian(reduce(lhs), lhsLimbs);
+            int[] rhsLimbs = lhs == rhs ? lhsLimbs : littleEndian(reduce(rhs), this.rhsLimbs);
+            montgomery(resultLimbs, lhsLimbs, rhsLimbs, r2);
+            return fromLittleEndian(resultLimbs);
+        }
+
+        public Int9N modSquare(Int9N x) {
+            return modMul(x, x);
+        }
+
+        public Residue toMontgomery(Int9N x) {
+            var result = new Residue();
+            littleEndian(reduce(x), result.limbs);
+            montgomery(result.limbs, result.limbs, r2, null); // x * R^2 / R
+            return result;
+        }
+
+        public Int9N fromMontgomery(Residue x) {
+            montgomery(resultLimbs, check(x).limbs, one, null); // x * R / R
+            return fromLittleEndian(resultLimbs);
+        }
+
+        // dst = lhs * rhs, all in Montgomery form, dst may be lhs or rhs
+        public void modMulInPlace(Residue dst, Residue lhs, Residue rhs) {
+            montgomery(check(dst).limbs, check(lhs).limbs, check(rhs).limbs, null);
+        }
+
+        public void modSquareInPlace(Residue dst, Residue x) {
+            modMulInPlace(dst, x, x);
+        }
+
+        private Residue check(Residue x) {
+            if (x.context() != this) {
+                throw new IllegalArgumentException("Residue of another ModContext");
+            }
+            return x;
+        }
+
+        // result = lhs * rhs / R mod modulus, times r2 / R again unless r2 is null
+        private void montgomery(int[] result, int[] lhs, int[] rhs, int[] r2) {
+            var tuning = tuning();
+            modMultiplyCore(result, lhs, rhs, limbs, inverse, r2, scratch(0, tuning), tuning.karatsubaThreshold, tuning.toomCook3Threshold);
+        }
+
+        private int[] scratch(int windowBits, Tuning tuning) {
+            if (windowBits == 0 && tuning == scratchTuning) {
+                return scratch;
+            }
+            long length = modMultiplyScratchLength(limbs.length, windowBits, tuning.karatsubaThreshold, tuning.toomCook3Threshold);
+            if (scratch == null || scratch.length < length) {
+                scratch = new int[Math.toIntExact(length)];
+            }
+            if (windowBits == 0) {
+                scratchTuning = tuning;
+            }
+            return scratch;
+        }
+
+        public Int9N modPow(Int9N base, int exponent) {
+            return modPow(base, fromInt(exponent));
+        }
+
+        public Int9N modPow(Int9N base, Int9N exponent) {
+            return modPow(base, exponent, 0);
+        }
+
+        /*
+         * Sliding-window exponentiation with the odd powers of the base up to base^(2^windowBits - 1),
+         * `windowBits` 0 chooses the window size that needs the fewest multiplications for the exponent.
+         */
+        public Int9N modPow(Int9N base, Int9N exponent, int windowBits) {
+            if (windowBits < 0 || windowBits > MAX_WINDOW_BITS) {
+                throw new IllegalArgumentException("Illegal window size: " + windowBits);
+            }
+            if (exponent.negative) {
+                throw new ArithmeticException("Negative exponent");
+            }
+            if (exponent.isZero()) {
+                return reduce(Constants.ONE());
+            }
+            var bits = exponent.toBigInteger();
+            if (windowBits == 0) {
+                windowBits = bestWindowBits(bits.bitLength());
+            }
+            var tuning = tuning();
+            modPowCore(resultLimbs, littleEndian(reduce(base), lhsLimbs), bits.toByteArray(), limbs, inverse, r2, windowBits,
+                    scratch(windowBits, tuning), tuning.karatsubaThreshold, tuning.toomCook3Threshold);
+            return fromLittleEndian(resultLimbs);
+        }
+
+        // 2^(k - 1) products for the table, and one per window of k bits and the zeroes until the next one, about k + 1 bits
+        private static int bestWindowBits(int bits) {
+            int k = 1;
+            while (k < MAX_WINDOW_BITS && (1 << k) + bits / (k + 2) < (1 << (k - 1)) + bits / (k + 1)) {
+                k++;
+            }
+            return k;
+        }
+
+        // -1 / m mod BASE, by Newton's iteration x *= 2 - m * x, which doubles the number of correct digits of 1 / m
+        private static int inverse(int m) {
+            long x = m % 10 == 3 ? 7 : m % 10 == 7 ? 3 : m % 10; // m * x = 1 mod 10
+            for (int i = 0; i < 4; i++) {
+                x = x * (2 + BASE1 - m * x % BASE1) % BASE1;
+            }
+            return (int) (BASE1 - x);
+        }
+
+        // the limbs of x (below the modulus) into result, which has the modulus' length
+        private static int[] littleEndian(Int9N x, int[] result) {
+            for (int i = 0; i < x.length; i++) {
+                result[i] = x.get(x.length - 1 - i);
+            }
+            Arrays.fill(result, x.length, result.length, 0);
+            return result;
+        }
+
+        private static Int9N fromLittleEndian(int[] limbs) {
+            int[] data = new int[limbs.length];
+            for (int i = 0; i < limbs.length; i++) {
+                data[i] = limbs[limbs.length - 1 - i];
+            }
+            return new Int9N(data).canonicalize();
+        }
+    }
+
+    /**
+     * Sums up numbers in carry-save form: their limbs are added into 64-bit cells without carrying,
+     * so a cell may exceed BASE (or go below 0, for subtractions) until the cells are normalized,
+     * which happens after MAX_PENDING additions at the latest, and for sum().
+     * Not thread-safe, summing() gives a Collector, which merges the partial sums with addAll().
+     */
+    public static final class Accumulator {
+
+        // after normalize(), the cells are in (-BASE, BASE), and every addition adds less than BASE
+        // to each, so their magnitude stays below (MAX_PENDING + 2) * BASE < 2^63
+        private static final int MAX_PENDING = 1 << 30;
+
+        private long[] cells = new long[4]; // the weight BASE^k at cells[cells.length - 1 - k], like the limbs of a number
+        private int used; // number of weights, the cells above are 0
+        private int pending; // additions since the last normalize()
+
+        public Accumulator add(Int9N x) {
+            return addLimbs(x, x.negative);
+        }
+
+        public Accumulator subtract(Int9N x) {
+            return addLimbs(x, !x.negative);
+        }
+
+        public Accumulator add(long x) {
+            if (pending >= MAX_PENDING) {
+                normalize();
+            }
+            reserve(3);
+            for (int i = cells.length - 1; x != 0; i--) {
+                cells[i] += x % BASE1; // with the sign of x
+                x /= BASE1;
+            }
+            pending++;
+            return this;
+        }
+
+        // this += other, which is not modified
+        public Accumulator addAll(Accumulator other) {
+            if ((long) pending + other.pending + 1 > MAX_PENDING) {
+                normalize();
+            }
+            reserve(other.used);
+            int shift = cells.length - other.cells.length;
+            for (int i = other.cells.length - other.used; i < other.cells.length; i++) {
+                cells[i + shift] += other.cells[i];
+            }
+            pending += other.pending + 1; // cells of other's last normalize() count as one addition
+            return this;
+        }
+
+        // the sum so far, more numbers can be added afterwards
+        public Int9N sum() {
+            normalize();
+            if (used == 0) {
+                return Constants.ZERO();
+            }
+            int top = cells.length - used;
+            if (cells[top] > 0) {
+                return limbs(top);
+            }
+            // the cells below the top one are not negative
+            var rest = used > 1 ? limbs(top + 1).canonicalize() : Constants.ZERO();
+            return Int9N.add(rest, fromLong(cells[top]).shiftLeft(used - 1));
+        }
+
+        private Accumulator addLimbs(Int9N x, boolean subtract) {
+            if (x.isZero()) {
+                return this;
+            }
+            if (pending >= MAX_PENDING) {
+                normalize();
+            }
+            reserve(x.length);
+            // data[j] has the weight BASE^(offset + length - 1 - j), without the zeroes of "trailingZeroesForm"
+            int shift = cells.length - x.offset - x.length;
+            int[] data = x.data;
+            int size = x.extent();
+            if (subtract) {
+                for (int j = x.offset; j < size; j++) {
+                    cells[j + shift] -= data[j];
+                }
+            } else {
+                for (int j = x.offset; j < size; j++) {
+                    cells[j + shift] += data[j];
+                }
+            }
+            pending++;
+            return this;
+        }
+
+        // makes room for that many weights
+        private void reserve(int weights) {
+            if (weights > cells.length) {
+                var grown = new long[Math.max(weights, 2 * cells.length)];
+                System.arraycopy(cells, cells.length - used, grown, grown.length - used, used);
+                cells = grown;
+            }
+            used = Math.max(used, weights);
+        }
 
-            @Override
-            protected Int9N compute() {
-                return fn.get();
+        // carries all cells into [0, BASE), up to the top one, which stays in (-BASE, BASE) for a negative sum
+        private void normalize() {
+            long carry = 0;
+            for (int i = cells.length - 1; i > cells.length - used; i--) {
+                long value = cells[i] + carry;
+                carry = Math.floorDiv(value, BASE1);
+                cells[i] = value - carry * BASE1;
+            }
+            if (used > 0) {
+                cells[cells.length - used] += carry;
+                while (Math.abs(cells[cells.length - used]) >= BASE1) {
+                    int top = cells.length - used;
+                    carry = Math.floorDiv(cells[top], BASE1);
+                    cells[top] -= carry * BASE1;
+                    reserve(used + 1);
+                    cells[cells.length - used] = carry;
+                }
+            }
+            while (used > 0 && cells[cells.length - used] == 0) {
+                used--;
             }
-        });
+            pending = 0;
+        }
+
+        // the normalized cells [from, cells.length) as a number
+        private Int9N limbs(int from) {
+            int[] data = new int[cells.length - from];
+            for (int i = 0; i < data.length; i++) {
+                data[i] = (int) cells[from + i];
+            }
+            return new Int9N(data);
+        }
     }
 
-    /*
-     * CharSequence API
+    /**
+     * Counters of the multiplication kernels, per Kind: calls, nanoseconds spent in them, and
+     * a histogram of the product lengths (bucket i counts lhsLength + rhsLength in [2^i, 2^(i+1))),
+     * plus the bytes allocated for scratch space. Only counted after setStats(true).
+     * Every thread counts into its own instance, without synchronization; snapshot() adds them up,
+     * which may miss the increments of other threads still running at the time.
+     * The MBean OBJECT_NAME exposes the same (and setStats()) via JMX.
      */
+    public static final class Stats {
 
-    @Override
-    public int length() {
-        return (negative ? 1 : 0) + countDigits();
-    }
+        public static final String OBJECT_NAME = "philippag.compint:type=Int9N.Stats";
 
-    // random access to a digit w/o needing to materialize a string
-    // this is optimized to not have any divisions.
-    // Note: a solution with cached segments of 9-digit-substring was tried
-    // and actually performed worse than this...
-    @Override
-    public char charAt(int index) {
-        if (negative) {
-            if (index == 0) {
-                return '-';
-            }
-            index--;
+        public enum Kind {
+            SCHOOLBOOK,      // long multiplication: multiplyCore(), multiplyColumnsCore(), squareCore()
+            KARATSUBA,       // the native Karatsuba and Toom-Cook-3 recursion, multiplySubquadraticCore()
+            NTT,             // multiplyNttCore()
+            PARALLEL,        // parallelMultiplyKaratsuba() as a whole, its sub-products count as the above, too
+            PARALLEL_NATIVE, // multiplyParallelDirectCore()
         }
-        // correct for variable length of first element in data[]
-        index += SIZE - firstDigitLength();
 
-        int div9 = DivMulTable.div9(index);
-        int idx = offset + div9;
-        return idx < data.length ? IntegerFormat.at(data[idx], DivMulTable.mod9(div9, index)) : '0';
-    }
+        public static final int BUCKETS = 32;
 
-    @Override
-    public Int9N subSequence(int start, int end) {
-        // we must not return `this` b/c of mutability
-        return fromString(this, start, end);
-    }
+        private static final Kind[] KINDS = Kind.values();
+        private static final List<Stats> THREADS = new ArrayList<>(); // guarded by itself
+        private static final Stats RETIRED = new Stats(null); // of terminated threads, guarded by THREADS
+        private static final ThreadLocal<Stats> CURRENT = ThreadLocal.withInitial(Stats::register);
+        private static int pruneAt = 64; // THREADS size at which register() folds terminated threads into RETIRED, guarded by THREADS
+        private static boolean registered; // the MBean, guarded by Stats.class
 
-    private static class Calc {
+        private final WeakReference<Thread> owner;
+        private final long[] calls = new long[KINDS.length];
+        private final long[] nanos = new long[KINDS.length];
+        private final long[] histogram = new long[KINDS.length * BUCKETS];
+        private long scratchBytes;
 
-        static int maxDepth(ForkJoinPool pool) {
-            return maxDepth(pool.getParallelism());
+        private Stats(Thread owner) {
+            this.owner = owner == null ? null : new WeakReference<>(owner);
         }
 
-        static int maxDepth(int parallelism) {
-            return bitLength(parallelism) << 1; // e.g. 4=>6, 8=>8, 16=>10
+        private static Stats register() {
+            var stats = new Stats(Thread.currentThread());
+            synchronized (THREADS) {
+                if (THREADS.size() >= pruneAt) {
+                    // also without anyone calling snapshot(), so that a thread per task doesn't pile up
+                    prune(null);
+                    pruneAt = Math.max(64, 2 * THREADS.size());
+                }
+                THREADS.add(stats);
+            }
+            return stats;
+        }
+
+        // folds terminated threads into RETIRED, sums up the others into `sum` unless it's null
+        private static void prune(Stats sum) {
+            assert Thread.holdsLock(THREADS);
+            for (var it = THREADS.iterator(); it.hasNext();) {
+                var stats = it.next();
+                var thread = stats.owner.get();
+                if (thread == null || !thread.isAlive()) {
+                    RETIRED.addAll(stats); // final, as the thread is done
+                    it.remove();
+                } else if (sum != null) {
+                    sum.addAll(stats);
+                }
+            }
         }
 
-        static int bitLength(long w) {
-            return 64 - Long.numberOfLeadingZeros(w);
+        static void record(Kind kind, int lhsLength, int rhsLength, long start) {
+            long elapsed = System.nanoTime() - start;
+            int bucket = Math.min(BUCKETS - 1, 63 - Long.numberOfLeadingZeros((long) lhsLength + rhsLength));
+            var stats = CURRENT.get();
+            int k = kind.ordinal();
+            stats.calls[k]++;
+            stats.nanos[k] += elapsed;
+            stats.histogram[k * BUCKETS + bucket]++;
         }
 
-        static boolean isPowerOfTwo(long w) {
-            assert w > 0;
-            return (w & (w - 1)) == 0;
+        static void recordScratch(long bytes) {
+            CURRENT.get().scratchBytes += bytes;
         }
 
-        static int lengthOf(long n) {
-            assert n >= 0;
-            return n < BASE1 ? 1 : n < BASE2 ? 2 : 3;
+        // the sum over all threads so far
+        public static Stats snapshot() {
+            var sum = new Stats(null);
+            synchronized (THREADS) {
+                prune(sum);
+                sum.addAll(RETIRED);
+            }
+            return sum;
         }
 
-        static int lengthForDigits(int digits) {
-            int div9 = DivMulTable.div9(digits);
-            int mod9 = DivMulTable.mod9(div9, digits);
-            return div9 + (mod9 == 0 ? 0 : 1);
+        private void addAll(Stats other) {
+            for (int i = 0; i < calls.length; i++) {
+                calls[i] += other.calls[i];
+                nanos[i] += other.nanos[i];
+            }
+            for (int i = 0; i < histogram.length; i++) {
+                histogram[i] += other.histogram[i];
+            }
+            scratchBytes += other.scratchBytes;
         }
 
-        static int addInPlaceCapacity(int lhs, int rhs) {
-            return lhs > rhs ? 1 : 1 + rhs - lhs; // always need one more space for 999_999_999 + 1 case!
+        public long getCalls(Kind kind) {
+            return calls[kind.ordinal()];
         }
 
-        static int subtractInPlaceCapacity(int lhs, int rhs) {
-            return lhs > rhs ? 0 : rhs - lhs;
+        public long getNanos(Kind kind) {
+            return nanos[kind.ordinal()];
         }
-    }
-
-    private static class AddWithCarry {
 
-        static int value(int accumulator) {
-            return accumulator < BASE ? accumulator : accumulator - BASE;
+        public long[] getHistogram(Kind kind) {
+            int from = kind.ordinal() * BUCKETS;
+            return Arrays.copyOfRange(histogram, from, from + BUCKETS);
         }
 
-        static int carry(int accumulator) {
-            return accumulator < BASE ? 0 : 1;
+        // JNI (or java.lang.foreign) calls into the kernels, i.e. all but PARALLEL
+        public long getNativeCalls() {
+            long sum = 0;
+            for (var kind : KINDS) {
+                if (kind != Kind.PARALLEL) {
+                    sum += getCalls(kind);
+                }
+            }
+            return sum;
         }
-    }
 
-    private static class SubtractWithCarry {
+        public long getScratchBytes() {
+            return scratchBytes;
+        }
 
-        static int value(int accumulator) {
-            return accumulator >= 0 ? accumulator : accumulator + BASE;
+        @Override
+        public String toString() {
+            var sb = new StringBuilder();
+            for (var kind : KINDS) {
+                sb.append(kind).append(": ").append(getCalls(kind)).append(" calls, ").append(getNanos(kind) / 1_000_000).append(" ms; ");
+            }
+            return sb.append("scratch: ").append(scratchBytes).append(" bytes").toString();
         }
 
-        static int carry(int accumulator) {
-            return accumulator >= 0 ? 0 : -1;
+        static synchronized void registerMBean() {
+            if (registered) {
+                return;
+            }
+            try {
+                ManagementFactory.getPlatformMBeanServer().registerMBean(new Bean(), new ObjectName(OBJECT_NAME));
+            } catch (InstanceAlreadyExistsException e) {
+                // e.g. by another class loader
+            } catch (JMException e) {
+                throw new IllegalStateException(e);
+            }
+            registered = true;
         }
-    }
 
-    private static class SubtractWithCarryComplement {
+        public interface StatsMXBean {
 
-        static int value(int accumulator) {
-            return BASE - (accumulator > 0 ? accumulator : accumulator + BASE);
-        }
+            boolean isEnabled();
 
-        static int carry(int accumulator) {
-            return accumulator <= 0 ? 0 : 1;
+            void setEnabled(boolean enabled);
+
+            Map<String, Long> getCalls();
+
+            Map<String, Long> getNanos();
+
+            Map<String, long[]> getHistograms();
+
+            long getNativeCalls();
+
+            long getScratchBytes();
         }
-    }
 
-    private static class IntegerFormat {
+        private static final class Bean implements StatsMXBean {
 
-        static int parse(CharSequence str, int fromIndex, int toIndex) {
-            int result = 0;
-            assert fromIndex < toIndex;
-            assert toIndex - fromIndex <= SIZE; // need no overflow protection if this holds
+            @Override
+            public boolean isEnabled() {
+                return stats;
+            }
 
-            for (int i = fromIndex; i < toIndex; i++) {
-                char c = str.charAt(i);
-                if (!('0' <= c && c <= '9')) {
-                    throw new NumberFormatException("Non-digit character '" + c + "' at index " + i);
-                }
-                result = DivMulTable.mul10(result) + c - '0';
+            @Override
+            public void setEnabled(boolean enabled) {
+                setStats(enabled);
             }
 
-            return result;
-        }
+            @Override
+            public Map<String, Long> getCalls() {
+                var snapshot = snapshot();
+                var result = new LinkedHashMap<String, Long>();
+                for (var kind : KINDS) {
+                    result.put(kind.name(), snapshot.getCalls(kind));
+                }
+                return result;
+            }
 
-        // equivalent to String.valueOf(digit).charAt(idx)
-        static char at(int digit, int idx) {
-            assert 0 <= idx && idx < SIZE : idx;
-            return (char) (DivMulTable.mod10(DivMulTable.divPower10(digit, idx)) + '0');
-        }
+            @Override
+            public Map<String, Long> getNanos() {
+                var snapshot = snapshot();
+                var result = new LinkedHashMap<String, Long>();
+                for (var kind : KINDS) {
+                    result.put(kind.name(), snapshot.getNanos(kind));
+                }
+                return result;
+            }
 
-        static void format(byte[] dest, int n, int left, int right) {
-            for (int i = right - 1; i >= left; --i) {
-                if (n == 0) {
-                    dest[i] = '0';
-                } else {
-                    int div10 = DivMulTable.div10(n);
-                    dest[i] = (byte) (DivMulTable.mod10(div10, n) + '0');
-                    n = div10;
+            @Override
+            public Map<String, long[]> getHistograms() {
+                var snapshot = snapshot();
+                var result = new LinkedHashMap<String, long[]>();
+                for (var kind : KINDS) {
+                    result.put(kind.name(), snapshot.getHistogram(kind));
                 }
+                return result;
             }
-        }
 
-        static int length(int n) {
-            assert n < BASE;
-            return n < 100_000 ?         n <        100 ? n <        10 ? 1 : 2 : n <       1_000 ? 3
-                 : n <  10_000 ? 4 : 5 : n < 10_000_000 ? n < 1_000_000 ? 6 : 7 : n < 100_000_000 ? 8 : 9;
+            @Override
+            public long getNativeCalls() {
+                return snapshot().getNativeCalls();
+            }
+
+            @Override
+            public long getScratchBytes() {
+                return snapshot().getScratchBytes();
+            }
         }
     }
 
-    /**
-     * Collection of "magic numbers" to replace divisions with multiplications.
-     * It's quite surprising that this actually helps performance, i.e.
-     * the JIT doesn't seem to do this, or do it well.
-     * The "magic numbers" are actually -(modular inverses)- reciprocal numbers.
-     * They were found using Compiler Explorer.
-     */
-    private static class DivMulTable {
+    private static class OffHeap {
 
-        private static final int[] MOD_INV = { // MOD_INV[i] == (1 << SHR[i]) / POWERS_OF_TEN[i] + 1; // except for last one
-        /*1E8*/ 0x55e63b89,
-                0x6b5fca6b,
-                0x431bde83,
-                0x14f8b589,
-                0x68db8bad,
-                0x10624dd3,
-                0x51eb851f,
-                0x66666667,
-        /*1E0*/ 1,
-        };
+        private static final ThreadLocal<ByteBuffer> BUFFERS = new ThreadLocal<>();
 
-        private static final int[] SHR = {
-        /*1E8*/ 57,
-                54,
-                50,
-                45,
-                44,
-                38,
-                37,
-                34,
-        /*1E0*/ 0,
-        };
+        // larger buffers are allocated per call, so that huge operands don't pin direct memory in every thread
+        private static final int MAX_CACHED_BYTES = 16 << 20;
 
-        // equivalent to input / POWERS_OF_TEN[idx] with POWERS_OF_TEN = { 1E8 .. 1E0 }
-        // Note: replacing the arrays with a switch seems to perform worse.
-        static int divPower10(long input, int idx) {
-            assert input >> 31 == 0; // so we don't need the subtraction part
-            return (int) ((input * MOD_INV[idx]) >> SHR[idx]);
-        }
+        final ByteBuffer buffer;
+        final int lhsLength;
+        final int rhsIndex;
+        final int rhsLength;
+        final int resultIndex;
+        final int scratchIndex;
 
-        static int div10(int input) {
-            assert input >> 31 == 0; // so we don't need the subtraction part
-            return (int) ((input * 0x66666667L) >> 34);
+        private OffHeap(ByteBuffer buffer, int lhsLength, int rhsIndex, int rhsLength) {
+            this.buffer = buffer;
+            this.lhsLength = lhsLength;
+            this.rhsIndex = rhsIndex;
+            this.rhsLength = rhsLength;
+            this.resultIndex = rhsIndex + rhsLength;
+            this.scratchIndex = resultIndex + lhsLength + rhsLength;
         }
 
-        static int mod10(int input) {
-            return mod10(div10(input), input);
+        /*
+         * Copies the operands to the calling thread's buffer: lhs at index 0,
+         * then rhs (unless it's a square), then room for the product and `scratchLength` ints.
+         * Returns null if that doesn't fit into a ByteBuffer.
+         */
+        static OffHeap stage(int[] lhs, int lhsOffset, int lhsLength, int[] rhs, int rhsOffset, int rhsLength, long scratchLength) {
+            boolean square = lhs == rhs && lhsOffset == rhsOffset && lhsLength == rhsLength;
+            int rhsIndex = square ? 0 : lhsLength;
+            var buffer = buffer((long) rhsIndex + rhsLength + lhsLength + rhsLength + scratchLength);
+            if (buffer == null) {
+                return null;
+            }
+            var ints = buffer.asIntBuffer();
+            ints.put(0, lhs, lhsOffset, lhsLength);
+            if (!square) {
+                ints.put(rhsIndex, rhs, rhsOffset, rhsLength);
+            }
+            return new OffHeap(buffer, lhsLength, rhsIndex, rhsLength);
         }
 
-        static int mod10(int div10, int input) {
-            return input - mul10(div10);
+        /*
+         * The calling thread's buffer, with room for at least `length` ints, or null if that doesn't fit into a ByteBuffer.
+         * Up to MAX_CACHED_BYTES, the buffer is kept for the next call (and only grows), beyond that it's a new one.
+         */
+        static ByteBuffer buffer(long length) {
+            if (length > Integer.MAX_VALUE / Integer.BYTES) {
+                return null;
+            }
+            int bytes = (int) length * Integer.BYTES;
+            var buffer = BUFFERS.get();
+            if (buffer == null || buffer.capacity() < bytes) {
+                if (stats) {
+                    Stats.recordScratch(bytes);
+                }
+                buffer = ByteBuffer.allocateDirect(bytes).order(ByteOrder.nativeOrder());
+                if (bytes <= MAX_CACHED_BYTES) {
+                    BUFFERS.set(buffer);
+                }
+            }
+            return buffer;
         }
 
-        static int mul10(int input) {
-            return (input + (input << 2)) << 1;
+        // the product's least significant limb goes to result[resultLength - shift], like in multiplyCore()
+        void copyProduct(int[] result, int resultLength, int shift) {
+            int productLength = lhsLength + rhsLength;
+            buffer.asIntBuffer().get(resultIndex, result, resultLength - shift - productLength + 1, productLength);
         }
+    }
 
-        static long div3(long input) {
-            return (input * 0xAAAAAAABL) >> 33;
-        }
+    private static class ScratchArena {
 
-        static long mod3(long div3, long input) {
-            return input - mul3(div3);
-        }
+        private static final ThreadLocal<int[]> SCRATCH = new ThreadLocal<>();
 
-        static long mul3(long input) {
-            return input + (input << 1);
+        // an array of at least `length` ints, with arbitrary contents, see setScratchArena()
+        static int[] scratch(long length) {
+            int size = Math.toIntExact(length);
+            if (!scratchArena) {
+                if (stats) {
+                    Stats.recordScratch((long) size * Integer.BYTES);
+                }
+                return new int[size];
+            }
+            int[] scratch = SCRATCH.get();
+            if (scratch == null || scratch.length < size) {
+                if (stats) {
+                    Stats.recordScratch((long) size * Integer.BYTES);
+                }
+                scratch = new int[size];
+                SCRATCH.set(scratch);
+            }
+            return scratch;
         }
+    }
 
-        static int div9(int input) {
-            assert input >> 31 == 0; // so we don't need the subtraction part
-            return (int) ((input * 0x38e38e39L) >> 33);
+    /*
+     * Binds the plain C entry points int9_multiply() et al. of the library that NativeLibLoader loaded.
+     * The downcalls are "critical": they take the heap arrays as they are,
+     * and skip the thread state transitions which JNI calls go through.
+     * Hence they must be short, as GC waits for them, just like for JNI critical sections.
+     */
+    @SuppressWarnings("restricted")
+    private static class Foreign {
+
+        private static final FunctionDescriptor MULTIPLY = FunctionDescriptor.ofVoid(
+                ValueLayout.ADDRESS, ValueLayout.JAVA_INT, ValueLayout.JAVA_INT,
+                ValueLayout.ADDRESS, ValueLayout.JAVA_INT, ValueLayout.JAVA_INT,
+                ValueLayout.ADDRESS, ValueLayout.JAVA_INT, ValueLayout.JAVA_INT);
+        private static final FunctionDescriptor SQUARE = FunctionDescriptor.ofVoid(
+                ValueLayout.ADDRESS, ValueLayout.JAVA_INT, ValueLayout.JAVA_INT,
+                ValueLayout.ADDRESS, ValueLayout.JAVA_INT, ValueLayout.JAVA_INT);
+
+        private static final MethodHandle MULTIPLY_CORE = downcall("int9_multiply", MULTIPLY);
+        private static final MethodHandle MULTIPLY_COLUMNS_CORE = downcall("int9_multiply_columns", MULTIPLY);
+        private static final MethodHandle SQUARE_CORE = downcall("int9_square", SQUARE);
+
+        private static MethodHandle downcall(String name, FunctionDescriptor descriptor) {
+            var symbol = SymbolLookup.loaderLookup().find(name).orElseThrow(() -> new UnsatisfiedLinkError("Native symbol not found: " + name));
+            return Linker.nativeLinker().downcallHandle(symbol, descriptor, Linker.Option.critical(/*allowHeapAccess*/ true));
+        }
+
+        static void multiplyCore(
+                int[] result, int resultLength, int shift,
+                int[] lhs, int lhsOffset, int lhsMax,
+                int[] rhs, int rhsOffset, int rhsMax) {
+            try {
+                MULTIPLY_CORE.invokeExact(
+                        MemorySegment.ofArray(result), resultLength, shift,
+                        MemorySegment.ofArray(lhs), lhsOffset, lhsMax,
+                        MemorySegment.ofArray(rhs), rhsOffset, rhsMax);
+            } catch (Error | RuntimeException e) {
+                throw e;
+            } catch (Throwable e) {
+                throw new IllegalStateException(e);
+            }
         }
 
-        static int mod9(int div9, int input) {
-            return input - mul9(div9);
+        static void multiplyColumnsCore(
+                int[] result, int resultLength, int shift,
+                int[] lhs, int lhsOffset, int lhsMax,
+                int[] rhs, int rhsOffset, int rhsMax) {
+            try {
+                MULTIPLY_COLUMNS_CORE.invokeExact(
+                        MemorySegment.ofArray(result), resultLength, shift,
+                        MemorySegment.ofArray(lhs), lhsOffset, lhsMax,
+                        MemorySegment.ofArray(rhs), rhsOffset, rhsMax);
+            } catch (Error | RuntimeException e) {
+                throw e;
+            } catch (Throwable e) {
+                throw new IllegalStateException(e);
+            }
         }
 
-        static int mul9(int input) {
-            return (input << 3) + input;
+        static void squareCore(
+                int[] result, int resultLength, int shift,
+                int[] lhs, int lhsOffset, int lhsMax) {
+            try {
+                SQUARE_CORE.invokeExact(
+                        MemorySegment.ofArray(result), resultLength, shift,
+                        MemorySegment.ofArray(lhs), lhsOffset, lhsMax);
+            } catch (Error | RuntimeException e) {
+                throw e;
+            } catch (Throwable e) {
+                throw new IllegalStateException(e);
+            }
         }
     }
 
-    private static class NativeLibLoader {
+    static class NativeLibLoader {
 
         private static final String PREFIX_FILE = "file:";
         private static final String PREFIX_JAR = "jar:file:";
 
+        // /proc/cpuinfo flags required by x86-64-v2, -v3 and -v4, each level on top of the previous one
+        private static final List<List<String>> X86_64_LEVELS = List.of(
+                List.of("cx16", "lahf_lm", "popcnt", "pni", "sse4_1", "sse4_2", "ssse3"),
+                List.of("abm", "avx", "avx2", "bmi1", "bmi2", "f16c", "fma", "movbe", "xsave"),
+                List.of("avx512f", "avx512bw", "avx512cd", "avx512dq", "avx512vl"));
+
+        static File library; // once loaded
+
+        /**
+         * Loads the most specific build of the given native library that this CPU can run, see variants().
+         * Builds that are not in the class path, or fail to load, are skipped.
+         * There is no Java fallback: if none loads, the native methods throw UnsatisfiedLinkError.
+         */
+        private static boolean loadBestVariant(Class<?> cls, String baseName, boolean autoExtract) {
+            var names = variants(baseName, System.getProperty("os.arch"), System.getProperty("os.name"), cpuFeatures());
+            var found = new ArrayList<String>();
+            for (var name : names) {
+                if (cls.getResource(name) != null) {
+                    if (loadAsResource(cls, name, autoExtract)) {
+                        return true;
+                    }
+                    found.add(name);
+                }
+            }
+            System.err.printf("ERROR [%s]: None of the native libraries %s could be loaded (found in class path: %s), "
+                    + "arithmetic will throw UnsatisfiedLinkError\n", cls.getName(), names, found);
+            return false;
+        }
+
+        /**
+         * The file names of the builds of the given library (see the Makefile) that run on the given
+         * architecture with the given CPU features, most specific first. The last one is the plain build
+         * for the machine it was built on.
+         */
+        static List<String> variants(String baseName, String arch, String os, Set<String> cpuFeatures) {
+            String suffix = os.startsWith("Windows") ? ".dll" : os.startsWith("Mac") ? ".dylib" : ".so";
+            var names = new ArrayList<String>();
+            switch (arch) {
+                case "amd64", "x86_64" -> {
+                    int level = 0;
+                    while (level < X86_64_LEVELS.size() && cpuFeatures.containsAll(X86_64_LEVELS.get(level))) {
+                        level++;
+                    }
+                    for (int v = level + 1; v >= 2; v--) {
+                        names.add(baseName + "-x86-64-v" + v + suffix);
+                    }
+                }
+                case "aarch64", "arm64" -> {
+                    if (cpuFeatures.contains("sve")) {
+                        names.add(baseName + "-aarch64-sve" + suffix);
+                    }
+                    names.add(baseName + "-aarch64" + suffix); // NEON is part of ARMv8-A
+                }
+                default -> {}
+            }
+            names.add(baseName + suffix);
+            return names;
+        }
+
+        // "flags" (x86) or "Features" (ARM) of the first CPU in /proc/cpuinfo, none if not on Linux
+        private static Set<String> cpuFeatures() {
+            try (var lines = Files.lines(new File("/proc/cpuinfo").toPath())) {
+                String features = lines.filter(line -> line.startsWith("flags") || line.startsWith("Features")).findFirst().orElse("");
+                return new HashSet<>(Arrays.asList(features.substring(features.indexOf(':') + 1).trim().split("\\s+")));
+            } catch (IOException | UncheckedIOException e) {
+                return Set.of();
+            }
+        }
+
         /**
          * Loads the given native library deployed as a class path resource.
          * There's 2 ways to load the given shared object:
@@ -1921,7 +4468,14 @@ private static boolean loadAsResource(Class<?> cls, String libName, boolean auto
 
             var file = new File(fileName);
             if (file.exists()) {
-                System.load(file.getPath());
+                try {
+                    System.load(file.getPath());
+                } catch (UnsatisfiedLinkError e) {
+                    // e.g. built for another architecture
+                    System.err.printf("ERROR [%s]: Could not load native library '%s': %s\n", cls.getName(), file, e.getMessage());
+                    return false;
+                }
+                library = file;
                 return true;
             } else {
                 System.err.printf("ERROR [%s]: Expecting native library '%s' at this location: '%s'\n", cls.getName(), libName, file);
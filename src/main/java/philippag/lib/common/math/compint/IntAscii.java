@@ -377,6 +377,31 @@ public static void setForkJoinPool(ForkJoinPool pool) {
         forkJoinPool = pool;
     }
 
+    private static int karatsubaThreshold = KARATSUBA_THRESHOLD;
+
+    // the threshold of all methods without an explicit one, e.g. the one from calibrateKaratsubaThreshold()
+    public static void setKaratsubaThreshold(int threshold) {
+        if (threshold < 1) {
+            throw new IllegalArgumentException("Illegal threshold: " + threshold);
+        }
+        karatsubaThreshold = threshold;
+    }
+
+    public static int getKaratsubaThreshold() {
+        return karatsubaThreshold;
+    }
+
+    /*
+     * Times multiplyKaratsuba() with a few thresholds on random operands of 2560 digits (after a warm-up)
+     * and returns the fastest one, for setKaratsubaThreshold(). Takes a fraction of a second.
+     */
+    public static int calibrateKaratsubaThreshold() {
+        var rnd = Calibration.random();
+        var lhs = fromString(Calibration.randomDigits(rnd, 2_560));
+        var rhs = fromString(Calibration.randomDigits(rnd, 2_560));
+        return Calibration.fastest(new int[] { 20, 40, 80, 160, 320 }, threshold -> multiplyKaratsuba(lhs, rhs, threshold));
+    }
+
     /* ============================
      * static functional arithmetic
      * ============================
@@ -522,7 +547,7 @@ IntAscii rightPart(int n) {
     }
 
     public static IntAscii multiplyKaratsuba(IntAscii lhs, IntAscii rhs) {
-        return multiplyKaratsuba(lhs, rhs, KARATSUBA_THRESHOLD);
+        return multiplyKaratsuba(lhs, rhs, karatsubaThreshold);
     }
 
     public static IntAscii multiplyKaratsuba(IntAscii lhs, IntAscii rhs, int threshold) {
@@ -582,7 +607,7 @@ private static IntAscii multiplyKaratsubaImpl(IntAscii lhs, IntAscii rhs, int th
     }
 
     public static IntAscii parallelMultiplyKaratsuba(IntAscii lhs, IntAscii rhs, ForkJoinPool pool) {
-        return parallelMultiplyKaratsubaForward(0, lhs, rhs, KARATSUBA_THRESHOLD, Calc.maxDepth(pool), pool);
+        return parallelMultiplyKaratsubaForward(0, lhs, rhs, karatsubaThreshold, Calc.maxDepth(pool), pool);
     }
 
     public static IntAscii parallelMultiplyKaratsuba(IntAscii lhs, IntAscii rhs, int threshold, int maxDepth, ForkJoinPool pool) {
@@ -1,4 +1,12 @@
 #include <jni.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define _USE_X86_SIMD
+#endif
 
 #ifdef _USE_ASSERT
     #include <assert.h>
@@ -9,6 +17,274 @@
 
 #define BASE 1000000000 // 1E9
 
+// Below this operand size the native Karatsuba always uses long multiplication,
+// regardless of the threshold given: for smaller sizes the split doesn't shrink the
+// sub-products anymore ((n + 1) / 2 + 1 >= n), so the recursion wouldn't terminate.
+#define KARATSUBA_MIN_LENGTH 3
+
+/*
+ * Long multiplication kernels.
+ *
+ * Instead of normalizing every single product to base 1E9, products are summed up
+ * in 64-bit column accumulators: (BASE - 1)^2 < 2^60, so TILE_ROWS rows of products
+ * can be added onto a normalized accumulator before it has to be carried.
+ * The rows themselves are then free of any dependency chain and vectorize well,
+ * mul_rows points to the best variant for the CPU we run on (see JNI_OnLoad()).
+ *
+ * The operands are processed in tiles which are copied into aligned, zero-padded
+ * little-endian buffers first, so all kernels work on both limb orders.
+ */
+
+#define TILE_LENGTH 256
+#define TILE_ROWS 16 // TILE_ROWS * (BASE - 1)^2 + 2 * BASE < 2^64
+#define TILE_PAD 32 // zeroes around a tile of the first operand, enough for two of the widest vectors
+
+// t[i + j] += a[i] * b[j] for 0 <= i < na, 0 <= j < rows, where a[-TILE_PAD, na + TILE_PAD) is readable
+typedef void (* mul_rows_fn)(uint64_t * t, const uint32_t * a, jint na, const uint32_t * b, jint rows);
+
+static void mul_rows_scalar(uint64_t * t, const uint32_t * a, jint na, const uint32_t * b, jint rows) {
+    for (jint j = 0; j < rows; j++) {
+        uint64_t rhsValue = b[j];
+        uint64_t * row = t + j;
+        for (jint i = 0; i < na; i++) {
+            row[i] += a[i] * rhsValue;
+        }
+    }
+}
+
+#ifdef _USE_X86_SIMD
+// column-wise: one accumulator vector stays in a register while all rows are added
+__attribute__((target("avx2")))
+static void mul_rows_avx2(uint64_t * t, const uint32_t * a, jint na, const uint32_t * b, jint rows) {
+    for (jint k = 0; k < na + rows - 1; k += 8) {
+        __m256i sum0 = _mm256_loadu_si256((const __m256i *) (t + k));
+        __m256i sum1 = _mm256_loadu_si256((const __m256i *) (t + k + 4));
+        for (jint j = 0; j < rows; j++) {
+            __m256i rhsValue = _mm256_set1_epi64x(b[j]);
+            __m256i lhsValues0 = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *) (a + k - j)));
+            __m256i lhsValues1 = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *) (a + k - j + 4)));
+            sum0 = _mm256_add_epi64(sum0, _mm256_mul_epu32(lhsValues0, rhsValue));
+            sum1 = _mm256_add_epi64(sum1, _mm256_mul_epu32(lhsValues1, rhsValue));
+        }
+        _mm256_storeu_si256((__m256i *) (t + k), sum0);
+        _mm256_storeu_si256((__m256i *) (t + k + 4), sum1);
+    }
+}
+
+__attribute__((target("avx512f")))
+static void mul_rows_avx512(uint64_t * t, const uint32_t * a, jint na, const uint32_t * b, jint rows) {
+    for (jint k = 0; k < na + rows - 1; k += 16) {
+        __m512i sum0 = _mm512_loadu_si512((const void *) (t + k));
+        __m512i sum1 = _mm512_loadu_si512((const void *) (t + k + 8));
+        for (jint j = 0; j < rows; j++) {
+            __m512i rhsValue = _mm512_set1_epi64(b[j]);
+            __m512i lhsValues0 = _mm512_cvtepu32_epi64(_mm256_loadu_si256((const __m256i *) (a + k - j)));
+            __m512i lhsValues1 = _mm512_cvtepu32_epi64(_mm256_loadu_si256((const __m256i *) (a + k - j + 8)));
+            sum0 = _mm512_add_epi64(sum0, _mm512_mul_epu32(lhsValues0, rhsValue));
+            sum1 = _mm512_add_epi64(sum1, _mm512_mul_epu32(lhsValues1, rhsValue));
+        }
+        _mm512_storeu_si512((void *) (t + k), sum0);
+        _mm512_storeu_si512((void *) (t + k + 8), sum1);
+    }
+}
+#endif
+
+static mul_rows_fn mul_rows = mul_rows_scalar;
+
+// carries t[from, to) and on as far as needed, returns the carry out of t[n - 1]
+static uint64_t normalize(uint64_t * t, jint from, jint to, jint n) {
+    uint64_t carry = 0;
+    jint k = from;
+    for (; k < to || (carry != 0 && k < n); k++) {
+        uint64_t value = t[k] + carry;
+        t[k] = value % BASE;
+        carry = value / BASE;
+    }
+    return carry;
+}
+
+// copies the tile operand a[0, n) into the zero-padded buffer `padded`, returns the start
+static uint32_t * tile_copy(uint32_t * padded, const jint * a, jint step, jint n) {
+    uint32_t * p = padded + TILE_PAD;
+    for (jint i = -TILE_PAD; i < 0; i++) {
+        p[i] = 0;
+    }
+    for (jint i = 0; i < n; i++) {
+        p[i] = (uint32_t) a[i * step];
+    }
+    for (jint i = n; i < n + TILE_PAD; i++) {
+        p[i] = 0;
+    }
+    return p;
+}
+
+static void tile_load(uint64_t * t, const jint * r, jint step, jint n) {
+    for (jint k = 0; k < n; k++) {
+        t[k] = (uint32_t) r[k * step];
+    }
+    for (jint k = n; k < n + TILE_PAD; k++) {
+        t[k] = 0;
+    }
+}
+
+// stores the normalized t[0, n) back to r, and adds `carry` to r[n] and on, up to r[room - 1],
+// returns what is left of the carry
+static uint64_t tile_store(jint * r, jint step, const uint64_t * t, jint n, uint64_t carry, jint room) {
+    for (jint k = 0; k < n; k++) {
+        r[k * step] = (jint) t[k];
+    }
+    for (jint k = n; carry != 0 && k < room; k++) {
+        uint64_t value = (uint32_t) r[k * step] + carry;
+        r[k * step] = (jint) (value % BASE);
+        carry = value / BASE;
+    }
+    return carry;
+}
+
+/*
+ * r += a * b, where the limb of weight BASE^i is found at a[i * step], likewise for b and r.
+ * `step` is 1 for little-endian vectors, and -1 for the big-endian Java arrays.
+ * r has nr >= na + nb limbs, returns the carry out of r[nr - 1].
+ */
+static jint mul_add_tiles(jint * r, jint step, const jint * a, jint na, const jint * b, jint nb, jint nr) {
+    ASSERT(nr >= na + nb);
+    uint32_t lhs[TILE_PAD + TILE_LENGTH + TILE_PAD];
+    uint32_t rhs[TILE_LENGTH];
+    uint64_t t[2 * TILE_LENGTH + TILE_PAD];
+    uint64_t overflow = 0;
+
+    for (jint ia = 0; ia < na; ia += TILE_LENGTH) {
+        jint nc = na - ia < TILE_LENGTH ? na - ia : TILE_LENGTH;
+        uint32_t * ap = tile_copy(lhs, a + ia * step, step, nc);
+
+        for (jint ib = 0; ib < nb; ib += TILE_LENGTH) {
+            jint nd = nb - ib < TILE_LENGTH ? nb - ib : TILE_LENGTH;
+            jint n = nc + nd;
+            jint * rp = r + (ia + ib) * step;
+            for (jint j = 0; j < nd; j++) {
+                rhs[j] = (uint32_t) b[(ib + j) * step];
+            }
+            tile_load(t, rp, step, n);
+
+            uint64_t carry = 0;
+            for (jint j = 0; j < nd; j += TILE_ROWS) {
+                jint rows = nd - j < TILE_ROWS ? nd - j : TILE_ROWS;
+                mul_rows(t + j, ap, nc, rhs + j, rows);
+                carry += normalize(t, j, j + nc + rows - 1, n);
+            }
+
+            overflow += tile_store(rp, step, t, n, carry, nr - ia - ib);
+        }
+    }
+    return (jint) overflow;
+}
+
+// r += a * b, the sum must fit into na + nb limbs
+static void mul_tiles(jint * r, jint step, const jint * a, jint na, const jint * b, jint nb) {
+    mul_add_tiles(r, step, a, na, b, nb, na + nb);
+}
+
+/*
+ * r = a^2 with the same limb addressing as mul_tiles().
+ * The cross products a[i] * a[j] with i < j are summed up once,
+ * then doubled, and the squares a[i]^2 are added in the same pass.
+ * Tiles below the diagonal are skipped entirely; within a diagonal tile,
+ * each block of rows multiplies with the part of the tile left of it
+ * (a growing copy, so that the kernels still see zeroes past its end),
+ * and with itself, as a small triangle.
+ * For short operands those triangles cost more than the saved products.
+ */
+
+#define SQR_TILES_MIN_LENGTH 96
+static void sqr_tiles(jint * r, jint step, const jint * a, jint na) {
+    uint32_t lhs[TILE_PAD + TILE_LENGTH + TILE_PAD];
+    uint32_t rhs[TILE_PAD + TILE_LENGTH + TILE_PAD];
+    uint64_t t[2 * TILE_LENGTH + TILE_PAD];
+
+    for (jint k = 0; k < 2 * na; k++) {
+        r[k * step] = 0;
+    }
+    if (na < SQR_TILES_MIN_LENGTH) {
+        mul_tiles(r, step, a, na, a, na);
+        return;
+    }
+    for (jint ia = 0; ia < na; ia += TILE_LENGTH) {
+        jint nc = na - ia < TILE_LENGTH ? na - ia : TILE_LENGTH;
+        jint * rp = r + 2 * ia * step;
+        uint32_t * ap = tile_copy(lhs, a + ia * step, step, nc);
+        uint32_t * left = rhs + TILE_PAD;
+        for (jint i = -TILE_PAD; i < nc + TILE_PAD; i++) {
+            left[i] = 0;
+        }
+        tile_load(t, rp, step, 2 * nc);
+
+        uint64_t carry = 0;
+        for (jint j = 0; j < nc; j += TILE_ROWS) {
+            jint rows = nc - j < TILE_ROWS ? nc - j : TILE_ROWS;
+            if (j > 0) {
+                mul_rows(t + j, left, j, ap + j, rows);
+                carry += normalize(t, j, 2 * j + rows - 1, 2 * nc);
+            }
+            for (jint jj = j + 1; jj < j + rows; jj++) {
+                uint64_t rhsValue = ap[jj];
+                for (jint i = j; i < jj; i++) {
+                    t[i + jj] += ap[i] * rhsValue;
+                }
+            }
+            carry += normalize(t, 2 * j, 2 * (j + rows) - 1, 2 * nc);
+            for (jint i = j; i < j + rows; i++) {
+                left[i] = ap[i];
+            }
+        }
+        tile_store(rp, step, t, 2 * nc, carry, 2 * (na - ia));
+
+        for (jint ib = ia + TILE_LENGTH; ib < na; ib += TILE_LENGTH) {
+            jint nd = na - ib < TILE_LENGTH ? na - ib : TILE_LENGTH;
+            jint n = nc + nd;
+            rp = r + (ia + ib) * step;
+            uint32_t * bp = tile_copy(rhs, a + ib * step, step, nd);
+            tile_load(t, rp, step, n);
+
+            carry = 0;
+            for (jint j = 0; j < nd; j += TILE_ROWS) {
+                jint rows = nd - j < TILE_ROWS ? nd - j : TILE_ROWS;
+                mul_rows(t + j, ap, nc, bp + j, rows);
+                carry += normalize(t, j, j + nc + rows - 1, n);
+            }
+            tile_store(rp, step, t, n, carry, 2 * na - ia - ib);
+        }
+    }
+
+    uint64_t carry = 0;
+    for (jint i = 0; i < na; i++) {
+        uint64_t value = a[i * step];
+        value *= value;
+        uint64_t low = 2 * (uint64_t) (uint32_t) r[2 * i * step] + value % BASE + carry;
+        uint64_t high = 2 * (uint64_t) (uint32_t) r[(2 * i + 1) * step] + value / BASE + low / BASE;
+        r[2 * i * step] = (jint) (low % BASE);
+        r[(2 * i + 1) * step] = (jint) (high % BASE);
+        carry = high / BASE;
+    }
+    ASSERT(carry == 0);
+}
+
+// same as multiplyCore() with lhs being rhs, result = lhs^2
+JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_squareCore(
+        JNIEnv * env, jclass cls,
+        jintArray resultArray, jint resultLength, jint shift,
+        jintArray lhsArray, jint lhsOffset, jint lhsMax) {
+
+    jint * lhs = (*env)->GetPrimitiveArrayCritical(env, lhsArray, /*isCopy*/ NULL);
+    jint * result = (*env)->GetPrimitiveArrayCritical(env, resultArray, /*isCopy*/ NULL);
+
+    ASSERT(lhs && result);
+
+    sqr_tiles(result + resultLength - shift, -1, lhs + lhsMax, lhsMax - lhsOffset + 1);
+
+    (*env)->ReleasePrimitiveArrayCritical(env, resultArray, result, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, lhsArray, lhs, JNI_ABORT);
+}
+
 // "gradle school" multiplication algorithm aka "long multiplication"
 JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_multiplyCore(
         JNIEnv * env, jclass cls,
@@ -34,27 +310,10 @@ JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_multiplyCore
 
     ASSERT(lhs && rhs && result);
 
-    for (jint i = rhsMax; i >= rhsOffset; --i, ++shift) {
-        jint carry = 0;
-        jint rhsValue = rhs[i];
-        jint k = resultLength - shift;
-
-        for (jint j = lhsMax; j >= lhsOffset; --j, --k) {
-            jlong lhsValue = lhs[j]; // force multiplication in jlong
-            jlong product = carry + lhsValue * rhsValue;
-            carry =    (jint) (product / BASE);
-            jint sum = (jint) (product % BASE) + result[k];
-            if (sum >= BASE) {
-                sum -= BASE;
-                ASSERT(sum < BASE);
-                carry++;
-            }
-            result[k] = sum;
-        }
-
-        ASSERT(result[k] == 0);
-        result[k] = carry;
-    }
+    // the product's least significant limb goes to result[resultLength - shift]
+    mul_tiles(result + resultLength - shift, -1,
+            lhs + lhsMax, lhsMax - lhsOffset + 1,
+            rhs + rhsMax, rhsMax - rhsOffset + 1);
 
     // these are only needed to end the critical section and let GC continue to work... I guess
     // call them in reverse
@@ -64,3 +323,2269 @@ JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_multiplyCore
     (*env)->ReleasePrimitiveArrayCritical(env, lhsArray, lhs, JNI_ABORT); // didn't write!
 #endif
 }
+
+/*
+ * Same as multiplyCore(), but result += lhs * rhs, where result is an accumulator
+ * with limbs down to result[resultOffset]. Returns the carry out of result[resultOffset].
+ */
+JNIEXPORT jint JNICALL Java_philippag_lib_common_math_compint_Int9N_multiplyAddCore(
+        JNIEnv * env, jclass cls,
+        jintArray resultArray, jint resultOffset, jint resultLength, jint shift,
+        jintArray lhsArray, jint lhsOffset, jint lhsMax,
+        jintArray rhsArray, jint rhsOffset, jint rhsMax) {
+
+    jint * lhs = (*env)->GetPrimitiveArrayCritical(env, lhsArray, /*isCopy*/ NULL);
+    jint * rhs = (*env)->GetPrimitiveArrayCritical(env, rhsArray, /*isCopy*/ NULL);
+    jint * result = (*env)->GetPrimitiveArrayCritical(env, resultArray, /*isCopy*/ NULL);
+
+    ASSERT(lhs && rhs && result);
+
+    jint carry = mul_add_tiles(result + resultLength - shift, -1,
+            lhs + lhsMax, lhsMax - lhsOffset + 1,
+            rhs + rhsMax, rhsMax - rhsOffset + 1,
+            resultLength - shift - resultOffset + 1);
+
+    (*env)->ReleasePrimitiveArrayCritical(env, resultArray, result, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, rhsArray, rhs, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, lhsArray, lhs, JNI_ABORT);
+    return carry;
+}
+
+/*
+ * Product scanning ("Comba") long multiplication: r += a * b, one column of
+ * products at a time, with the same limb addressing as mul_tiles().
+ * Each column is summed up in a split accumulator `low + BASE * high`, which is
+ * folded every TILE_ROWS products, and only carried once at the end of the column,
+ * so every result limb is written exactly once.
+ * `b` is copied in reverse, that way each column is a plain dot product of
+ * two ascending vectors, which the compiler vectorizes.
+ * Operands longer than COLUMNS_MAX_LENGTH go to mul_tiles() instead.
+ */
+
+#define COLUMNS_MAX_LENGTH 1024
+
+static uint64_t dot(const uint32_t * a, const uint32_t * b, jint n) {
+    uint64_t sum = 0;
+    for (jint i = 0; i < n; i++) {
+        sum += (uint64_t) a[i] * b[i];
+    }
+    return sum;
+}
+
+static void mul_columns(jint * r, jint step, const jint * a, jint na, const jint * b, jint nb) {
+    if (na > COLUMNS_MAX_LENGTH || nb > COLUMNS_MAX_LENGTH) {
+        mul_tiles(r, step, a, na, b, nb);
+        return;
+    }
+    uint32_t lhs[COLUMNS_MAX_LENGTH];
+    uint32_t rhs[COLUMNS_MAX_LENGTH]; // rhs[nb - 1 - j] = b[j]
+    for (jint i = 0; i < na; i++) {
+        lhs[i] = (uint32_t) a[i * step];
+    }
+    for (jint j = 0; j < nb; j++) {
+        rhs[nb - 1 - j] = (uint32_t) b[j * step];
+    }
+
+    uint64_t carry = 0;
+    for (jint k = 0; k < na + nb - 1; k++) {
+        jint from = k < nb ? 0 : k - nb + 1;
+        jint to = k < na ? k + 1 : na;
+        const uint32_t * column = rhs + nb - 1 - k; // column[i] = b[k - i]
+        uint64_t low = carry + (uint32_t) r[k * step];
+        uint64_t high = 0;
+
+        for (jint i = from; i < to; i += TILE_ROWS) {
+            jint n = to - i < TILE_ROWS ? to - i : TILE_ROWS;
+            low += dot(lhs + i, column + i, n);
+            high += low / BASE;
+            low %= BASE;
+        }
+
+        r[k * step] = (jint) low;
+        carry = high;
+    }
+    for (jint k = na + nb - 1; carry != 0; k++) {
+        ASSERT(k < na + nb);
+        uint64_t value = (uint32_t) r[k * step] + carry;
+        r[k * step] = (jint) (value % BASE);
+        carry = value / BASE;
+    }
+}
+
+JNIEXPORT jboolean JNICALL Java_philippag_lib_common_math_compint_Int9N_multiplyCoreVectorized(
+        JNIEnv * env, jclass cls) {
+
+    return mul_rows != mul_rows_scalar;
+}
+
+// same as multiplyCore(), but scans the result column by column
+JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_multiplyColumnsCore(
+        JNIEnv * env, jclass cls,
+        jintArray resultArray, jint resultLength, jint shift,
+        jintArray lhsArray, jint lhsOffset, jint lhsMax,
+        jintArray rhsArray, jint rhsOffset, jint rhsMax) {
+
+    jint * lhs = (*env)->GetPrimitiveArrayCritical(env, lhsArray, /*isCopy*/ NULL);
+    jint * rhs = (*env)->GetPrimitiveArrayCritical(env, rhsArray, /*isCopy*/ NULL);
+    jint * result = (*env)->GetPrimitiveArrayCritical(env, resultArray, /*isCopy*/ NULL);
+
+    ASSERT(lhs && rhs && result);
+
+    mul_columns(result + resultLength - shift, -1,
+            lhs + lhsMax, lhsMax - lhsOffset + 1,
+            rhs + rhsMax, rhsMax - rhsOffset + 1);
+
+    (*env)->ReleasePrimitiveArrayCritical(env, resultArray, result, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, rhsArray, rhs, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, lhsArray, lhs, JNI_ABORT);
+}
+
+/*
+ * Addition and subtraction kernels.
+ *
+ * A carry loop is one long dependency chain. Instead, the SIMD variants add up blocks
+ * of 64 limbs lane by lane, and compare the sums against BASE - 1 into two bit masks:
+ * g ("generate", the lane carries out anyway) and p ("propagate", the lane carries out
+ * only if a carry comes in). The carries into all 64 lanes then follow from a single
+ * 64-bit addition, like in a carry-lookahead adder: c = ((g << 1 | carry) + p) ^ p.
+ * Subtraction works the same with borrows, g being "difference < 0" and p "difference == 0".
+ * add_n and sub_n point to the best variant for the CPU (see JNI_OnLoad()).
+ *
+ * Limbs are addressed like for mul_tiles(): the limb of weight BASE^i is at a[i * step].
+ */
+
+// r = a + b + carry with n limbs each, returns the carry out, r may be a or b
+typedef jint (* add_n_fn)(jint * r, const jint * a, const jint * b, jint n, jint step, jint carry);
+
+static jint add_n_scalar(jint * r, const jint * a, const jint * b, jint n, jint step, jint carry) {
+    for (jint i = 0; i < n; i++) {
+        jint sum = a[i * step] + b[i * step] + carry;
+        carry = sum >= BASE;
+        r[i * step] = carry ? sum - BASE : sum;
+    }
+    return carry;
+}
+
+// r = a - b - borrow with n limbs each, returns the borrow out, r may be a or b
+static jint sub_n_scalar(jint * r, const jint * a, const jint * b, jint n, jint step, jint borrow) {
+    for (jint i = 0; i < n; i++) {
+        jint diff = a[i * step] - b[i * step] - borrow;
+        borrow = diff < 0;
+        r[i * step] = borrow ? diff + BASE : diff;
+    }
+    return borrow;
+}
+
+#ifdef _USE_X86_SIMD
+#define LANES_BLOCK 64 // bits of the masks
+
+// limbs i to i + 7, in ascending weights
+__attribute__((target("avx2")))
+static inline __m256i lanes_load(const jint * a, jint i, jint step) {
+    if (step > 0) {
+        return _mm256_loadu_si256((const __m256i *) (a + i));
+    }
+    __m256i v = _mm256_loadu_si256((const __m256i *) (a - i - 7));
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+__attribute__((target("avx2")))
+static inline void lanes_store(jint * r, jint i, jint step, __m256i v) {
+    if (step > 0) {
+        _mm256_storeu_si256((__m256i *) (r + i), v);
+    } else {
+        v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+        _mm256_storeu_si256((__m256i *) (r - i - 7), v);
+    }
+}
+
+__attribute__((target("avx2")))
+static inline uint64_t lanes_bits(__m256i mask, int k) {
+    return (uint64_t) (uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(mask)) << (8 * k);
+}
+
+// -1 in the lanes 8 * k to 8 * k + 7 whose bit is set in c, 0 in the others
+__attribute__((target("avx2")))
+static inline __m256i lanes_mask(uint64_t c, int k) {
+    const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32((int) (c >> (8 * k))), bits), bits);
+}
+
+// the carries into the lanes of a block, updates *carry to the carry out of the block
+static inline uint64_t lanes_carries(uint64_t g, uint64_t p, jint * carry) {
+    uint64_t in = g << 1 | (uint64_t) *carry;
+    uint64_t t = in + p;
+    *carry = (jint) ((g >> 63) | (t < in));
+    return t ^ p;
+}
+
+__attribute__((target("avx2")))
+static jint add_n_avx2(jint * r, const jint * a, const jint * b, jint n, jint step, jint carry) {
+    const __m256i max = _mm256_set1_epi32(BASE - 1);
+    const __m256i base = _mm256_set1_epi32(BASE);
+    jint i = 0;
+    for (; i + LANES_BLOCK <= n; i += LANES_BLOCK) {
+        __m256i sums[LANES_BLOCK / 8];
+        uint64_t g = 0;
+        uint64_t p = 0;
+        for (int k = 0; k < LANES_BLOCK / 8; k++) {
+            sums[k] = _mm256_add_epi32(lanes_load(a, i + 8 * k, step), lanes_load(b, i + 8 * k, step));
+            g |= lanes_bits(_mm256_cmpgt_epi32(sums[k], max), k);
+            p |= lanes_bits(_mm256_cmpeq_epi32(sums[k], max), k);
+        }
+        uint64_t c = lanes_carries(g, p, &carry);
+        for (int k = 0; k < LANES_BLOCK / 8; k++) {
+            __m256i sum = _mm256_sub_epi32(sums[k], lanes_mask(c, k)); // + 1 where a carry comes in
+            sum = _mm256_sub_epi32(sum, _mm256_and_si256(_mm256_cmpgt_epi32(sum, max), base));
+            lanes_store(r, i + 8 * k, step, sum);
+        }
+    }
+    return add_n_scalar(r + i * step, a + i * step, b + i * step, n - i, step, carry);
+}
+
+__attribute__((target("avx2")))
+static jint sub_n_avx2(jint * r, const jint * a, const jint * b, jint n, jint step, jint borrow) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i base = _mm256_set1_epi32(BASE);
+    jint i = 0;
+    for (; i + LANES_BLOCK <= n; i += LANES_BLOCK) {
+        __m256i diffs[LANES_BLOCK / 8];
+        uint64_t g = 0;
+        uint64_t p = 0;
+        for (int k = 0; k < LANES_BLOCK / 8; k++) {
+            diffs[k] = _mm256_sub_epi32(lanes_load(a, i + 8 * k, step), lanes_load(b, i + 8 * k, step));
+            g |= lanes_bits(_mm256_cmpgt_epi32(zero, diffs[k]), k);
+            p |= lanes_bits(_mm256_cmpeq_epi32(diffs[k], zero), k);
+        }
+        uint64_t c = lanes_carries(g, p, &borrow);
+        for (int k = 0; k < LANES_BLOCK / 8; k++) {
+            __m256i diff = _mm256_add_epi32(diffs[k], lanes_mask(c, k)); // - 1 where a borrow comes in
+            diff = _mm256_add_epi32(diff, _mm256_and_si256(_mm256_cmpgt_epi32(zero, diff), base));
+            lanes_store(r, i + 8 * k, step, diff);
+        }
+    }
+    return sub_n_scalar(r + i * step, a + i * step, b + i * step, n - i, step, borrow);
+}
+#endif
+
+static add_n_fn add_n = add_n_scalar;
+static add_n_fn sub_n = sub_n_scalar;
+
+/*
+ * lhs[lhsOffset..lhsMax] += rhs[rhsOffset..rhsMax], where both are big-endian and the
+ * least significant limbs are aligned, i.e. the caller shifts rhs by choosing lhsMax.
+ * lhs must be at least as long as rhs, returns the carry out of lhs[lhsOffset].
+ */
+JNIEXPORT jint JNICALL Java_philippag_lib_common_math_compint_Int9N_addCore(
+        JNIEnv * env, jclass cls,
+        jintArray lhsArray, jint lhsOffset, jint lhsMax,
+        jintArray rhsArray, jint rhsOffset, jint rhsMax) {
+
+    jint * lhs = (*env)->GetPrimitiveArrayCritical(env, lhsArray, /*isCopy*/ NULL);
+    jint * rhs = (*env)->GetPrimitiveArrayCritical(env, rhsArray, /*isCopy*/ NULL);
+
+    ASSERT(lhs && rhs);
+
+    jint nb = rhsMax - rhsOffset + 1;
+    ASSERT(lhsMax - lhsOffset + 1 >= nb);
+    jint carry = add_n(lhs + lhsMax, lhs + lhsMax, rhs + rhsMax, nb, -1, 0);
+    for (jint i = lhsMax - nb; carry != 0 && i >= lhsOffset; --i) {
+        carry = lhs[i] == BASE - 1;
+        lhs[i] = carry ? 0 : lhs[i] + 1;
+    }
+
+    (*env)->ReleasePrimitiveArrayCritical(env, rhsArray, rhs, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, lhsArray, lhs, JNI_ABORT);
+    return carry;
+}
+
+// lhs -= rhs, with the same coordinates as addCore(), returns the borrow out of lhs[lhsOffset]
+JNIEXPORT jint JNICALL Java_philippag_lib_common_math_compint_Int9N_subtractCore(
+        JNIEnv * env, jclass cls,
+        jintArray lhsArray, jint lhsOffset, jint lhsMax,
+        jintArray rhsArray, jint rhsOffset, jint rhsMax) {
+
+    jint * lhs = (*env)->GetPrimitiveArrayCritical(env, lhsArray, /*isCopy*/ NULL);
+    jint * rhs = (*env)->GetPrimitiveArrayCritical(env, rhsArray, /*isCopy*/ NULL);
+
+    ASSERT(lhs && rhs);
+
+    jint nb = rhsMax - rhsOffset + 1;
+    ASSERT(lhsMax - lhsOffset + 1 >= nb);
+    jint borrow = sub_n(lhs + lhsMax, lhs + lhsMax, rhs + rhsMax, nb, -1, 0);
+    for (jint i = lhsMax - nb; borrow != 0 && i >= lhsOffset; --i) {
+        borrow = lhs[i] == 0;
+        lhs[i] = borrow ? BASE - 1 : lhs[i] - 1;
+    }
+
+    (*env)->ReleasePrimitiveArrayCritical(env, rhsArray, rhs, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, lhsArray, lhs, JNI_ABORT);
+    return borrow;
+}
+
+/*
+ * Native multiplication engine.
+ *
+ * Unlike the Java side, which stores the most significant limb first,
+ * all routines below work on little-endian limb vectors,
+ * i.e. index 0 holds the least significant limb.
+ * This is the natural order for carry propagation, and it lets sub-products
+ * land at simple pointer offsets. The JNI entry points convert at the boundary,
+ * which is a linear cost next to the super-linear multiplication.
+ *
+ * Temporaries are never allocated natively; they are taken from a scratch buffer
+ * supplied by the caller, sized with multiplyScratchLength().
+ */
+
+static void reverse_copy(jint * dst, const jint * src, jint n) {
+    for (jint i = 0, j = n - 1; i < n; i++, --j) {
+        dst[i] = src[j];
+    }
+}
+
+static void reverse(jint * r, jint n) {
+    for (jint i = 0, j = n - 1; i < j; i++, --j) {
+        jint tmp = r[i];
+        r[i] = r[j];
+        r[j] = tmp;
+    }
+}
+
+static void zero(jint * r, jint n) {
+    for (jint i = 0; i < n; i++) {
+        r[i] = 0;
+    }
+}
+
+static jint trim(const jint * a, jint n) {
+    while (n > 0 && a[n - 1] == 0) {
+        --n;
+    }
+    return n;
+}
+
+// r = a + b, requires na >= nb, returns the carry out of r[na - 1]
+static jint add(jint * r, const jint * a, jint na, const jint * b, jint nb) {
+    ASSERT(na >= nb);
+    jint carry = add_n(r, a, b, nb, 1, 0);
+    jint i = nb;
+    for (; i < na && (carry != 0 || r != a); i++) {
+        jint sum = a[i] + carry;
+        carry = sum >= BASE;
+        r[i] = carry ? sum - BASE : sum;
+    }
+    return carry;
+}
+
+// r += a, requires nr >= na, the carry must not run out of r
+static void add_in(jint * r, jint nr, const jint * a, jint na) {
+    ASSERT(nr >= na);
+    jint carry = add(r, r, nr, a, na);
+    ASSERT(carry == 0);
+    (void) carry;
+}
+
+// r = a - b, requires na >= nb, returns the borrow out of r[na - 1]
+static jint sub(jint * r, const jint * a, jint na, const jint * b, jint nb) {
+    ASSERT(na >= nb);
+    jint borrow = sub_n(r, a, b, nb, 1, 0);
+    jint i = nb;
+    for (; i < na && (borrow != 0 || r != a); i++) {
+        jint diff = a[i] - borrow;
+        borrow = diff < 0;
+        r[i] = borrow ? diff + BASE : diff;
+    }
+    return borrow;
+}
+
+// r -= a, requires nr >= na and r >= a
+static void sub_in(jint * r, jint nr, const jint * a, jint na) {
+    ASSERT(nr >= na);
+    jint borrow = sub(r, r, nr, a, na);
+    ASSERT(borrow == 0);
+    (void) borrow;
+}
+
+// r = a * b, r must have room for na + nb limbs
+static void mul_basecase(jint * r, const jint * a, jint na, const jint * b, jint nb) {
+    zero(r, na + nb);
+    mul_tiles(r, 1, a, na, b, nb);
+}
+
+// crossover points of the native multiplication engine, in limbs
+struct thresholds {
+    jint karatsuba;
+    jint toom3;
+};
+
+static jlong mul_scratch(jint n, const struct thresholds * t) {
+    jlong size = 0;
+    while (n > t->karatsuba && n > KARATSUBA_MIN_LENGTH) {
+        jint m = n - (n >> 1);
+        jlong local = 4 * (jlong) m + 4; // Karatsuba: a0 + a1, b0 + b1 and their product
+        if (n > t->toom3) {
+            jint k = (n + 2) / 3;
+            jlong toom3 = 6 * ((jlong) k + 2) + 3 * (2 * (jlong) k + 4); // Toom-3: 6 evaluations, 3 products
+            if (toom3 > local) {
+                local = toom3;
+            }
+        }
+        size += local;
+        n = m + 1; // the biggest sub-product of both algorithms
+    }
+    return size;
+}
+
+static void mul(jint * r, const jint * a, jint na, const jint * b, jint nb, jint * scratch, const struct thresholds * t);
+
+/*
+ * The split is the same as on the Java side: the low parts have (n / 2) limbs,
+ * where n is the length of the longer operand `a`.
+ * Unbalanced operands (na >= 2 * nb) go to mul_chunks() instead, so `b` always has a high part.
+ */
+static void mul_karatsuba(jint * r, const jint * a, jint na, const jint * b, jint nb, jint * scratch, const struct thresholds * t) {
+    ASSERT(na >= nb && na < 2 * nb);
+    jint h = na >> 1;
+    jint m = na - h; // length of high part of a, m >= h
+
+    const jint * a0 = a;
+    const jint * a1 = a + h;
+    const jint * b0 = b;
+    const jint * b1 = b + h;
+    jint nb1 = nb - h;
+    ASSERT(0 < nb1 && nb1 <= m);
+
+    // ac and bd go straight to their final place in `r`
+    mul(r, a0, h, b0, h, scratch, t);
+    mul(r + 2 * h, a1, m, b1, nb1, scratch, t);
+
+    jint * sa = scratch;
+    jint * sb = sa + m + 1;
+    jint * middle = sb + m + 1;
+    jint * next = middle + 2 * m + 2;
+
+    sa[m] = add(sa, a1, m, a0, h);
+    jint nsa = trim(sa, m + 1);
+    jint nsb;
+    if (a == b) {
+        sb = sa;
+        nsb = nsa;
+    } else if (nb1 >= h) {
+        sb[nb1] = add(sb, b1, nb1, b0, h);
+        nsb = trim(sb, nb1 + 1);
+    } else {
+        sb[h] = add(sb, b0, h, b1, nb1);
+        nsb = trim(sb, h + 1);
+    }
+
+    // (a + b) * (c + d) - ac - bd = ad + bc
+    jint nmiddle = nsa + nsb;
+    mul(middle, sa, nsa, sb, nsb, next, t);
+    sub_in(middle, nmiddle, r, trim(r, 2 * h));
+    sub_in(middle, nmiddle, r + 2 * h, trim(r + 2 * h, na + nb - 2 * h));
+    add_in(r + h, na + nb - h, middle, trim(middle, nmiddle));
+}
+
+/*
+ * Signed numbers for the Toom-Cook evaluation and interpolation,
+ * which need negative intermediate values.
+ * The magnitude `d` is always trimmed, i.e. has no leading zeroes.
+ * The buffer behind `d` must have room for one more limb than the result.
+ */
+struct snum {
+    jint * d;
+    jint n;
+    jint negative;
+};
+
+static struct snum snum_of(const jint * d, jint n) {
+    struct snum x = { (jint *) d, trim(d, n), 0 };
+    return x;
+}
+
+static jint compare(const jint * a, jint na, const jint * b, jint nb) {
+    if (na != nb) {
+        return na < nb ? -1 : 1;
+    }
+    for (jint i = na - 1; i >= 0; --i) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+// r = x + y, or r = x - y when `subtract` is set; r may alias x or y
+static void snum_add(struct snum * r, const struct snum * x, const struct snum * y, jint subtract) {
+    const jint * a = x->d;
+    const jint * b = y->d;
+    jint na = x->n;
+    jint nb = y->n;
+    jint aNegative = x->negative;
+    jint bNegative = y->negative ^ subtract;
+
+    if (aNegative == bNegative) {
+        if (na < nb) {
+            const jint * t = a; a = b; b = t;
+            jint n = na; na = nb; nb = n;
+        }
+        r->d[na] = add(r->d, a, na, b, nb);
+        r->n = trim(r->d, na + 1);
+        r->negative = aNegative;
+    } else {
+        jint cmp = compare(a, na, b, nb);
+        if (cmp < 0) {
+            const jint * t = a; a = b; b = t;
+            jint n = na; na = nb; nb = n;
+            aNegative = bNegative;
+        }
+        jint borrow = sub(r->d, a, na, b, nb);
+        ASSERT(borrow == 0);
+        (void) borrow;
+        r->n = trim(r->d, na);
+        r->negative = r->n == 0 ? 0 : aNegative;
+    }
+}
+
+static void snum_double(struct snum * x) {
+    x->d[x->n] = add(x->d, x->d, x->n, x->d, x->n);
+    x->n = trim(x->d, x->n + 1);
+}
+
+// x = x / divisor, the division must be exact
+static void snum_divide_exact(struct snum * x, jint divisor) {
+    jlong remainder = 0;
+    for (jint i = x->n - 1; i >= 0; --i) {
+        jlong value = remainder * BASE + x->d[i];
+        x->d[i] = (jint) (value / divisor);
+        remainder = value % divisor;
+    }
+    ASSERT(remainder == 0);
+    x->n = trim(x->d, x->n);
+}
+
+static void snum_mul(struct snum * r, const struct snum * x, const struct snum * y, jint * scratch, const struct thresholds * t) {
+    mul(r->d, x->d, x->n, y->d, y->n, scratch, t);
+    r->n = trim(r->d, x->n + y->n);
+    r->negative = r->n == 0 ? 0 : x->negative ^ y->negative;
+}
+
+// p(1), p(-1) and p(-2) of p(x) = c2 x^2 + c1 x + c0
+static void toom3_evaluate(struct snum * p1, struct snum * pm1, struct snum * pm2,
+        const struct snum * c0, const struct snum * c1, const struct snum * c2) {
+
+    snum_add(p1, c0, c2, 0);        // c0 + c2
+    snum_add(pm1, p1, c1, 1);       // c0 - c1 + c2 = p(-1)
+    snum_add(p1, p1, c1, 0);        // c0 + c1 + c2 = p(1)
+    snum_add(pm2, pm1, c2, 0);      // c0 - c1 + 2 c2
+    snum_double(pm2);               // 2 c0 - 2 c1 + 4 c2
+    snum_add(pm2, pm2, c0, 1);      // c0 - 2 c1 + 4 c2 = p(-2)
+}
+
+/*
+ * Toom-Cook-3 with the evaluation points 0, 1, -1, -2 and infinity,
+ * and Bodrato's interpolation sequence, similar to java.math.BigInteger.
+ * Both operands are split into 3 parts of k limbs (the topmost part may be shorter),
+ * so `b` must be longer than 2k limbs.
+ */
+static void mul_toom3(jint * r, const jint * a, jint na, const jint * b, jint nb, jint * scratch, const struct thresholds * t) {
+    ASSERT(na >= nb);
+    jint k = (na + 2) / 3;
+    jint n = na + nb;
+    ASSERT(nb > 2 * k);
+
+    struct snum a0 = snum_of(a, k);
+    struct snum a1 = snum_of(a + k, k);
+    struct snum a2 = snum_of(a + 2 * k, na - 2 * k);
+    struct snum b0 = snum_of(b, k);
+    struct snum b1 = snum_of(b + k, k);
+    struct snum b2 = snum_of(b + 2 * k, nb - 2 * k);
+
+    jint ne = k + 2;     // evaluations are less than 7 B^k
+    jint np = 2 * k + 4; // products of evaluations and the interpolation's intermediate values
+
+    struct snum p1  = { scratch,            0, 0 };
+    struct snum pm1 = { p1.d + ne,          0, 0 };
+    struct snum pm2 = { pm1.d + ne,         0, 0 };
+    struct snum q1  = { pm2.d + ne,         0, 0 };
+    struct snum qm1 = { q1.d + ne,          0, 0 };
+    struct snum qm2 = { qm1.d + ne,         0, 0 };
+    struct snum w1  = { qm2.d + ne,         0, 0 };
+    struct snum wm1 = { w1.d + np,          0, 0 };
+    struct snum wm2 = { wm1.d + np,         0, 0 };
+    jint * next = wm2.d + np;
+
+    toom3_evaluate(&p1, &pm1, &pm2, &a0, &a1, &a2);
+    if (a == b) {
+        q1 = p1;
+        qm1 = pm1;
+        qm2 = pm2;
+    } else {
+        toom3_evaluate(&q1, &qm1, &qm2, &b0, &b1, &b2);
+    }
+
+    // r(0) and r(infinity) go straight to their final place in `r`
+    mul(r, a, k, b, k, next, t);
+    zero(r + 2 * k, 2 * k);
+    mul(r + 4 * k, a2.d, na - 2 * k, b2.d, nb - 2 * k, next, t);
+    struct snum w0 = snum_of(r, 2 * k);
+    struct snum winf = snum_of(r + 4 * k, n - 4 * k);
+
+    snum_mul(&w1, &p1, &q1, next, t);
+    snum_mul(&wm1, &pm1, &qm1, next, t);
+    snum_mul(&wm2, &pm2, &qm2, next, t);
+
+    snum_add(&wm2, &wm2, &w1, 1);   // r3 = (r(-2) - r(1)) / 3
+    snum_divide_exact(&wm2, 3);
+    snum_add(&w1, &w1, &wm1, 1);    // r1 = (r(1) - r(-1)) / 2
+    snum_divide_exact(&w1, 2);
+    snum_add(&wm1, &wm1, &w0, 1);   // r2 = r(-1) - r(0)
+    snum_add(&wm2, &wm1, &wm2, 1);  // r3 = (r2 - r3) / 2 + 2 r(infinity)
+    snum_divide_exact(&wm2, 2);
+    snum_add(&wm2, &wm2, &winf, 0);
+    snum_add(&wm2, &wm2, &winf, 0);
+    snum_add(&wm1, &wm1, &w1, 0);   // r2 = r2 + r1 - r(infinity)
+    snum_add(&wm1, &wm1, &winf, 1);
+    snum_add(&w1, &w1, &wm2, 1);    // r1 = r1 - r3
+
+    // the coefficients of the product are never negative
+    ASSERT(!w1.negative && !wm1.negative && !wm2.negative);
+    add_in(r + k,     n - k,     w1.d,  w1.n);
+    add_in(r + 2 * k, n - 2 * k, wm1.d, wm1.n);
+    add_in(r + 3 * k, n - 3 * k, wm2.d, wm2.n);
+}
+
+/*
+ * Unbalanced operands, na >= 2 * nb: `a` is cut into chunks of nb limbs, each of which is
+ * multiplied with `b` as a balanced product and added into r at its offset. Halving `a` instead
+ * would leave sub-products of up to 2 * nb x nb limbs, whose Karatsuba split runs on the zero high part of `b`.
+ * Needs 2 * nb + mul_scratch(nb) ints of scratch, which mul_scratch(na) covers.
+ */
+static void mul_chunks(jint * r, const jint * a, jint na, const jint * b, jint nb, jint * scratch, const struct thresholds * t) {
+    ASSERT(na >= 2 * nb);
+    jint * p = scratch; // chunk * b
+    mul(r, a, nb, b, nb, p, t);
+    zero(r + 2 * nb, na - nb);
+    for (jint i = nb; i < na; i += nb) {
+        jint nc = na - i < nb ? na - i : nb;
+        mul(p, a + i, nc, b, nb, p + nc + nb, t);
+        add_in(r + i, na + nb - i, p, nc + nb);
+    }
+}
+
+// r = a * b, r must have room for na + nb limbs, operands may have leading zeroes
+// squares are detected by a == b, and all algorithms pass that on to their sub-products
+static void mul(jint * r, const jint * a, jint na, const jint * b, jint nb, jint * scratch, const struct thresholds * t) {
+    jint n = na + nb;
+    na = trim(a, na);
+    nb = trim(b, nb);
+    zero(r + na + nb, n - na - nb);
+
+    if (na < nb) {
+        const jint * tmp = a; a = b; b = tmp;
+        n = na; na = nb; nb = n;
+    }
+    if (nb == 0) {
+        zero(r, na);
+    } else if (nb <= t->karatsuba || nb <= KARATSUBA_MIN_LENGTH) {
+        if (a == b) {
+            sqr_tiles(r, 1, a, na);
+        } else {
+            mul_basecase(r, a, na, b, nb);
+        }
+    } else if (na >= 2 * nb) {
+        mul_chunks(r, a, na, b, nb, scratch, t);
+    } else if (nb > t->toom3 && nb > 2 * ((na + 2) / 3)) {
+        mul_toom3(r, a, na, b, nb, scratch, t);
+    } else {
+        mul_karatsuba(r, a, na, b, nb, scratch, t);
+    }
+}
+
+// r = lhs * rhs, all big-endian, r has na + nb limbs, scratch is sized by multiplyScratchLength()
+static void mul_big_endian(jint * r, const jint * lhs, jint na, const jint * rhs, jint nb, jint * scratch, const struct thresholds * t) {
+    jint * a = scratch;
+    jint * b = a + na;
+    reverse_copy(a, lhs, na);
+    if (lhs == rhs && na == nb) {
+        b = a; // a square, let mul() know
+    } else {
+        reverse_copy(b, rhs, nb);
+    }
+    mul(r, a, na, b, nb, scratch + na + nb, t);
+    reverse(r, na + nb);
+}
+
+JNIEXPORT jlong JNICALL Java_philippag_lib_common_math_compint_Int9N_multiplyScratchLength(
+        JNIEnv * env, jclass cls,
+        jint lhsLength, jint rhsLength, jint karatsubaThreshold, jint toomCook3Threshold) {
+
+    struct thresholds t = { karatsubaThreshold, toomCook3Threshold };
+    jint n = lhsLength > rhsLength ? lhsLength : rhsLength;
+    return (jlong) lhsLength + rhsLength + mul_scratch(n, &t);
+}
+
+// same coordinates as multiplyCore(), plus a scratch buffer sized by multiplyScratchLength()
+JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_multiplySubquadraticCore(
+        JNIEnv * env, jclass cls,
+        jintArray resultArray, jint resultLength, jint shift,
+        jintArray lhsArray, jint lhsOffset, jint lhsMax,
+        jintArray rhsArray, jint rhsOffset, jint rhsMax,
+        jintArray scratchArray, jint karatsubaThreshold, jint toomCook3Threshold) {
+
+    jint * lhs = (*env)->GetPrimitiveArrayCritical(env, lhsArray, /*isCopy*/ NULL);
+    jint * rhs = (*env)->GetPrimitiveArrayCritical(env, rhsArray, /*isCopy*/ NULL);
+    jint * result = (*env)->GetPrimitiveArrayCritical(env, resultArray, /*isCopy*/ NULL);
+    jint * scratch = (*env)->GetPrimitiveArrayCritical(env, scratchArray, /*isCopy*/ NULL);
+
+    ASSERT(lhs && rhs && result && scratch);
+
+    struct thresholds t = { karatsubaThreshold, toomCook3Threshold };
+    jint na = lhsMax - lhsOffset + 1;
+    jint nb = rhsMax - rhsOffset + 1;
+
+    // the product's least significant limb goes to result[resultLength - shift]
+    jint * r = result + resultLength - shift - (na + nb) + 1;
+    ASSERT(r >= result);
+    mul_big_endian(r, lhs + lhsOffset, na, rhs + rhsOffset, nb, scratch, &t);
+
+    (*env)->ReleasePrimitiveArrayCritical(env, scratchArray, scratch, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, resultArray, result, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, rhsArray, rhs, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, lhsArray, lhs, JNI_ABORT);
+}
+
+/*
+ * Off-heap variant: all regions are int indexes into a direct buffer,
+ * whose address stays valid without a critical section, so GC can run meanwhile.
+ * The product (lhsLength + rhsLength limbs) goes to resultIndex, big-endian like the operands.
+ */
+JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_multiplySubquadraticDirectCore(
+        JNIEnv * env, jclass cls,
+        jobject buffer, jint resultIndex,
+        jint lhsIndex, jint lhsLength,
+        jint rhsIndex, jint rhsLength,
+        jint scratchIndex, jint karatsubaThreshold, jint toomCook3Threshold) {
+
+    jint * ints = (*env)->GetDirectBufferAddress(env, buffer);
+
+    ASSERT(ints);
+
+    struct thresholds t = { karatsubaThreshold, toomCook3Threshold };
+    mul_big_endian(ints + resultIndex, ints + lhsIndex, lhsLength, ints + rhsIndex, rhsLength, ints + scratchIndex, &t);
+}
+
+/*
+ * Parallel multiplication on native threads.
+ *
+ * The top levels of the recursion are planned up front, on the calling thread:
+ * Karatsuba splits (or, for unbalanced operands, chunks of the longer operand) down to
+ * at least 2 * threads independent sub-products ("leaves"). Then the threads take leaves
+ * off a shared counter and multiply them with mul(), each with a scratch area of its own,
+ * and finally the calling thread recombines the nodes bottom-up.
+ * The workers never call back into the JVM, the method returns once all of them are joined.
+ */
+
+#define PAR_MAX_DEPTH 5
+#define PAR_MAX_LEAVES 243 // 3 ^ PAR_MAX_DEPTH
+#define PAR_MAX_NODES 121 // (PAR_MAX_LEAVES - 1) / 2
+
+enum par_kind { PAR_LEAF, PAR_KARATSUBA, PAR_CHUNKS };
+
+// r = a * b, computed by one thread
+struct par_leaf {
+    jint * r;
+    const jint * a;
+    const jint * b;
+    jint na;
+    jint nb;
+};
+
+// r = a * b, recombined from the products of the node's children
+struct par_node {
+    jint * r;
+    jint n; // na + nb
+    jint h; // Karatsuba: length of the low parts; chunks: length of a chunk
+    jint nb;
+    jint * p; // Karatsuba: (a0 + a1) * (b0 + b1); chunks: a1 * b, then a2 * b
+    jint np;
+    enum par_kind kind;
+};
+
+struct par_mul {
+    const struct thresholds * t;
+    jint parallelThreshold;
+    jint threads;
+    jint depth;
+    jint * scratch; // the nodes' sums and products, bump-allocated
+    jlong used;
+    jint maxLeafLength;
+    jint nleaves;
+    jint nnodes;
+    jint next; // the next leaf to multiply, shared by all workers
+    struct par_leaf leaves[PAR_MAX_LEAVES];
+    struct par_node nodes[PAR_MAX_NODES];
+};
+
+struct par_worker {
+    struct par_mul * p;
+    jint * scratch;
+    pthread_t thread;
+};
+
+static void par_init(struct par_mul * p, jint threads, jint parallelThreshold, const struct thresholds * t) {
+    p->t = t;
+    p->parallelThreshold = parallelThreshold;
+    p->threads = threads < 1 ? 1 : threads < PAR_MAX_LEAVES ? threads : PAR_MAX_LEAVES;
+    p->depth = 0;
+    for (jint leaves = 1; p->threads > 1 && leaves < 2 * p->threads && p->depth < PAR_MAX_DEPTH; leaves *= 3) {
+        p->depth++;
+    }
+    p->scratch = NULL;
+    p->used = 0;
+    p->maxLeafLength = 0;
+    p->nleaves = 0;
+    p->nnodes = 0;
+    p->next = 0;
+}
+
+// requires na >= nb, every node has at most 3 children
+static enum par_kind par_choose(const struct par_mul * p, jint na, jint nb, jint depth) {
+    if (depth >= p->depth || nb == 0) {
+        return PAR_LEAF;
+    }
+    if (nb <= na >> 1) {
+        // b has no high part: multiply 3 chunks of a with all of b, like long multiplication by rows
+        return na > p->parallelThreshold && na > KARATSUBA_MIN_LENGTH ? PAR_CHUNKS : PAR_LEAF;
+    }
+    return nb > p->parallelThreshold && nb > p->t->karatsuba && nb > KARATSUBA_MIN_LENGTH ? PAR_KARATSUBA : PAR_LEAF;
+}
+
+// length of (b0 + b1) in a Karatsuba node, see mul_karatsuba()
+static jint par_sum_length(jint h, jint nb1) {
+    return (nb1 >= h ? nb1 : h) + 1;
+}
+
+// counts the leaves and the nodes' scratch of a plan for na * nb, like par_split() does
+static void par_count(struct par_mul * p, jint na, jint nb, jint depth) {
+    if (na < nb) {
+        jint tmp = na; na = nb; nb = tmp;
+    }
+    switch (par_choose(p, na, nb, depth)) {
+    case PAR_LEAF:
+        p->nleaves++;
+        if (na > p->maxLeafLength) {
+            p->maxLeafLength = na;
+        }
+        break;
+    case PAR_KARATSUBA: {
+        jint h = na >> 1;
+        jint m = na - h;
+        jint nsb = par_sum_length(h, nb - h);
+        p->used += 2 * ((jlong) m + 1 + nsb);
+        par_count(p, h, h, depth + 1);
+        par_count(p, m, nb - h, depth + 1);
+        par_count(p, m + 1, nsb, depth + 1);
+        break;
+    }
+    case PAR_CHUNKS: {
+        jint q = na / 3;
+        p->used += (jlong) q + nb + na - 2 * q + nb;
+        par_count(p, q, nb, depth + 1);
+        par_count(p, q, nb, depth + 1);
+        par_count(p, na - 2 * q, nb, depth + 1);
+        break;
+    }
+    }
+}
+
+static jint * par_alloc(struct par_mul * p, jlong n) {
+    jint * s = p->scratch + p->used;
+    p->used += n;
+    return s;
+}
+
+// plans r = a * b as a tree of nodes and leaves, r must have room for na + nb limbs
+static void par_split(struct par_mul * p, jint * r, const jint * a, jint na, const jint * b, jint nb, jint depth) {
+    if (na < nb) {
+        const jint * tmp = a; a = b; b = tmp;
+        jint n = na; na = nb; nb = n;
+    }
+    enum par_kind kind = par_choose(p, na, nb, depth);
+    if (kind == PAR_LEAF) {
+        ASSERT(p->nleaves < PAR_MAX_LEAVES);
+        struct par_leaf * leaf = &p->leaves[p->nleaves++];
+        leaf->r = r;
+        leaf->a = a;
+        leaf->na = na;
+        leaf->b = b;
+        leaf->nb = nb;
+        if (na > p->maxLeafLength) {
+            p->maxLeafLength = na;
+        }
+        return;
+    }
+    ASSERT(p->nnodes < PAR_MAX_NODES);
+    struct par_node * node = &p->nodes[p->nnodes++];
+    node->r = r;
+    node->n = na + nb;
+    node->nb = nb;
+    node->kind = kind;
+    if (kind == PAR_KARATSUBA) {
+        jint h = na >> 1;
+        jint m = na - h;
+        jint nb1 = nb - h;
+        jint nsb = par_sum_length(h, nb1);
+        jint * sa = par_alloc(p, m + 1);
+        jint * sb = par_alloc(p, nsb);
+        sa[m] = add(sa, a + h, m, a, h);
+        if (a == b) {
+            sb = sa; // nsb == m + 1 for squares
+        } else if (nb1 >= h) {
+            sb[nb1] = add(sb, b + h, nb1, b, h);
+        } else {
+            sb[h] = add(sb, b, h, b + h, nb1);
+        }
+        node->h = h;
+        node->np = m + 1 + nsb;
+        node->p = par_alloc(p, node->np);
+        // the sums have (at most) one leading zero limb, mul() trims it
+        par_split(p, r, a, h, b, h, depth + 1);
+        par_split(p, r + 2 * h, a + h, m, b + h, nb1, depth + 1);
+        par_split(p, node->p, sa, m + 1, sb, nsb, depth + 1);
+    } else {
+        jint q = na / 3;
+        node->h = q;
+        node->np = q + nb + na - 2 * q + nb;
+        node->p = par_alloc(p, node->np);
+        par_split(p, r, a, q, b, nb, depth + 1);
+        par_split(p, node->p, a + q, q, b, nb, depth + 1);
+        par_split(p, node->p + q + nb, a + 2 * q, na - 2 * q, b, nb, depth + 1);
+    }
+}
+
+static void par_combine(struct par_node * node) {
+    jint * r = node->r;
+    jint n = node->n;
+    jint h = node->h;
+    if (node->kind == PAR_KARATSUBA) {
+        // (a0 + a1) * (b0 + b1) - ac - bd = ad + bc
+        jint * middle = node->p;
+        sub_in(middle, node->np, r, trim(r, 2 * h));
+        sub_in(middle, node->np, r + 2 * h, trim(r + 2 * h, n - 2 * h));
+        add_in(r + h, n - h, middle, trim(middle, node->np));
+    } else {
+        jint nb = node->nb;
+        zero(r + h + nb, n - h - nb);
+        add_in(r + h, n - h, node->p, h + nb);
+        add_in(r + 2 * h, n - 2 * h, node->p + h + nb, n - 2 * h);
+    }
+}
+
+static void par_run(struct par_worker * w) {
+    struct par_mul * p = w->p;
+    jint i;
+    while ((i = __atomic_fetch_add(&p->next, 1, __ATOMIC_RELAXED)) < p->nleaves) {
+        struct par_leaf * leaf = &p->leaves[i];
+        mul(leaf->r, leaf->a, leaf->na, leaf->b, leaf->nb, w->scratch, p->t);
+    }
+}
+
+static void * par_thread(void * arg) {
+    par_run(arg);
+    return NULL;
+}
+
+// the number of threads that have leaves to work on, and the scratch length of each of them
+static jint par_workers(const struct par_mul * p, jlong * workerScratch) {
+    *workerScratch = mul_scratch(p->maxLeafLength, p->t);
+    return p->threads < p->nleaves ? p->threads : p->nleaves;
+}
+
+// scratch of par_mul_big_endian(): both operands, the nodes, and each worker's scratch
+static jlong par_mul_scratch(jint na, jint nb, jint threads, jint parallelThreshold, const struct thresholds * t) {
+    struct par_mul p;
+    par_init(&p, threads, parallelThreshold, t);
+    par_count(&p, na, nb, 0);
+    jlong workerScratch;
+    jint workers = par_workers(&p, &workerScratch);
+    return (jlong) na + nb + p.used + workers * workerScratch;
+}
+
+// like mul_big_endian(), with the work spread over `threads` threads
+static void par_mul_big_endian(jint * r, const jint * lhs, jint na, const jint * rhs, jint nb, jint * scratch,
+        jint threads, jint parallelThreshold, const struct thresholds * t) {
+
+    jint * a = scratch;
+    jint * b = a + na;
+    reverse_copy(a, lhs, na);
+    if (lhs == rhs && na == nb) {
+        b = a; // a square, let mul() know
+    } else {
+        reverse_copy(b, rhs, nb);
+    }
+
+    struct par_mul p;
+    par_init(&p, threads, parallelThreshold, t);
+    p.scratch = scratch + na + nb;
+    par_split(&p, r, a, na, b, nb, 0);
+
+    jlong workerScratch;
+    jint workers = par_workers(&p, &workerScratch);
+    struct par_worker w[PAR_MAX_LEAVES];
+    jint started = 1;
+    for (jint i = 0; i < workers; i++) {
+        w[i].p = &p;
+        w[i].scratch = p.scratch + p.used + i * workerScratch;
+    }
+    // if a thread can't be created, the others take over its leaves
+    while (started < workers && pthread_create(&w[started].thread, NULL, par_thread, &w[started]) == 0) {
+        started++;
+    }
+    par_run(&w[0]);
+    for (jint i = 1; i < started; i++) {
+        pthread_join(w[i].thread, NULL);
+    }
+
+    // children are planned after their parent, so this goes bottom-up
+    for (jint i = p.nnodes - 1; i >= 0; i--) {
+        par_combine(&p.nodes[i]);
+    }
+    reverse(r, na + nb);
+}
+
+JNIEXPORT jlong JNICALL Java_philippag_lib_common_math_compint_Int9N_multiplyParallelScratchLength(
+        JNIEnv * env, jclass cls,
+        jint lhsLength, jint rhsLength, jint threads,
+        jint parallelThreshold, jint karatsubaThreshold, jint toomCook3Threshold) {
+
+    struct thresholds t = { karatsubaThreshold, toomCook3Threshold };
+    return par_mul_scratch(lhsLength, rhsLength, threads, parallelThreshold, &t);
+}
+
+// like multiplySubquadraticDirectCore(), on `threads` native threads, scratch is sized by multiplyParallelScratchLength()
+JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_multiplyParallelDirectCore(
+        JNIEnv * env, jclass cls,
+        jobject buffer, jint resultIndex,
+        jint lhsIndex, jint lhsLength,
+        jint rhsIndex, jint rhsLength,
+        jint scratchIndex, jint threads,
+        jint parallelThreshold, jint karatsubaThreshold, jint toomCook3Threshold) {
+
+    jint * ints = (*env)->GetDirectBufferAddress(env, buffer);
+
+    ASSERT(ints);
+
+    struct thresholds t = { karatsubaThreshold, toomCook3Threshold };
+    par_mul_big_endian(ints + resultIndex, ints + lhsIndex, lhsLength, ints + rhsIndex, rhsLength, ints + scratchIndex,
+            threads, parallelThreshold, &t);
+}
+
+/*
+ * Number-theoretic transform (NTT) multiplication.
+ *
+ * The limbs are convolved modulo three primes below 2^31 that all support
+ * transforms of up to NTT_MAX_LENGTH points. Each coefficient of the convolution
+ * is less than min(na, nb) * BASE^2 < p0 * p1 * p2, so it is recovered exactly
+ * from its three residues by the Chinese remainder theorem (Garner's algorithm),
+ * and then carried into base 1E9 limbs.
+ *
+ * Modular products use Montgomery reduction with R = 2^32: residues stay in the
+ * normal domain while the twiddle factors are kept in Montgomery form,
+ * the leftover factors R^-1 are compensated in the final scaling.
+ */
+
+#define NTT_MAX_LENGTH (1 << 26) // p0 - 1 = 7 * 2^26
+#define NTT_BLOCK_LENGTH 4096 // sub-transforms of this size run iteratively, in cache
+
+struct ntt_prime {
+    uint32_t p;
+    uint32_t g; // primitive root
+    uint32_t n; // -p^-1 mod R
+    uint32_t r1; // R mod p, i.e. 1 in Montgomery form
+    uint32_t r2; // R^2 mod p
+};
+
+static const uint32_t NTT_PRIMES[3][2] = {
+    { 469762049,   3 }, //  7 * 2^26 + 1
+    { 1811939329, 13 }, // 27 * 2^26 + 1
+    { 2013265921, 31 }, // 15 * 2^27 + 1
+};
+
+static void ntt_prime_init(struct ntt_prime * q, uint32_t p, uint32_t g) {
+    uint32_t inv = p; // correct to 3 bits, every Newton step doubles that
+    for (int i = 0; i < 4; i++) {
+        inv *= 2 - p * inv;
+    }
+    q->p = p;
+    q->g = g;
+    q->n = -inv;
+    q->r1 = (uint32_t) (((uint64_t) 1 << 32) % p);
+    q->r2 = (uint32_t) ((uint64_t) q->r1 * q->r1 % p);
+}
+
+// a * b * R^-1 mod p, requires a * b < p * R
+static inline uint32_t mont_mul(uint32_t a, uint32_t b, const struct ntt_prime * q) {
+    uint64_t t = (uint64_t) a * b;
+    uint32_t m = (uint32_t) t * q->n;
+    uint32_t u = (uint32_t) ((t + (uint64_t) m * q->p) >> 32);
+    return u >= q->p ? u - q->p : u;
+}
+
+static inline uint32_t add_mod(uint32_t a, uint32_t b, uint32_t p) {
+    uint32_t s = a + b;
+    return s >= p ? s - p : s;
+}
+
+static inline uint32_t sub_mod(uint32_t a, uint32_t b, uint32_t p) {
+    return a >= b ? a - b : a + p - b;
+}
+
+// x^e in Montgomery form, for x in Montgomery form
+static uint32_t mont_pow(uint32_t x, uint32_t e, const struct ntt_prime * q) {
+    uint32_t r = q->r1;
+    for (; e > 0; e >>= 1) {
+        if (e & 1) {
+            r = mont_mul(r, x, q);
+        }
+        x = mont_mul(x, x, q);
+    }
+    return r;
+}
+
+static uint32_t mont_of(uint32_t x, const struct ntt_prime * q) {
+    return mont_mul(x % q->p, q->r2, q);
+}
+
+/*
+ * roots[h + j] = w^j for 0 <= j < h, where w is a primitive (2h)-th root of unity
+ * (or its inverse), for all powers of two h < n. That way every butterfly level
+ * of every sub-transform reads its twiddle factors sequentially.
+ */
+static void ntt_roots(uint32_t * roots, jint n, int inverse, const struct ntt_prime * q) {
+    uint32_t e = (q->p - 1) / n;
+    uint32_t w = mont_pow(mont_of(q->g, q), inverse ? (q->p - 1) - e : e, q);
+    jint h = n >> 1;
+    uint32_t x = q->r1;
+    for (jint j = 0; j < h; j++) {
+        roots[h + j] = x;
+        x = mont_mul(x, w, q);
+    }
+    for (h >>= 1; h > 0; h >>= 1) {
+        for (jint j = 0; j < h; j++) {
+            roots[h + j] = roots[2 * h + 2 * j];
+        }
+    }
+}
+
+// decimation in frequency, natural order in, bit-reversed order out
+static void ntt_forward(uint32_t * x, jint n, const uint32_t * roots, const struct ntt_prime * q) {
+    if (n > NTT_BLOCK_LENGTH) {
+        jint h = n >> 1;
+        for (jint j = 0; j < h; j++) {
+            uint32_t u = x[j];
+            uint32_t v = x[j + h];
+            x[j] = add_mod(u, v, q->p);
+            x[j + h] = mont_mul(sub_mod(u, v, q->p), roots[h + j], q);
+        }
+        ntt_forward(x, h, roots, q);
+        ntt_forward(x + h, h, roots, q);
+        return;
+    }
+    for (jint h = n >> 1; h > 0; h >>= 1) {
+        for (jint s = 0; s < n; s += 2 * h) {
+            for (jint j = 0; j < h; j++) {
+                uint32_t u = x[s + j];
+                uint32_t v = x[s + j + h];
+                x[s + j] = add_mod(u, v, q->p);
+                x[s + j + h] = mont_mul(sub_mod(u, v, q->p), roots[h + j], q);
+            }
+        }
+    }
+}
+
+// decimation in time, bit-reversed order in, natural order out, not scaled by 1/n
+static void ntt_inverse(uint32_t * x, jint n, const uint32_t * roots, const struct ntt_prime * q) {
+    if (n > NTT_BLOCK_LENGTH) {
+        jint h = n >> 1;
+        ntt_inverse(x, h, roots, q);
+        ntt_inverse(x + h, h, roots, q);
+        for (jint j = 0; j < h; j++) {
+            uint32_t u = x[j];
+            uint32_t v = mont_mul(x[j + h], roots[h + j], q);
+            x[j] = add_mod(u, v, q->p);
+            x[j + h] = sub_mod(u, v, q->p);
+        }
+        return;
+    }
+    for (jint h = 1; h < n; h <<= 1) {
+        for (jint s = 0; s < n; s += 2 * h) {
+            for (jint j = 0; j < h; j++) {
+                uint32_t u = x[s + j];
+                uint32_t v = mont_mul(x[s + j + h], roots[h + j], q);
+                x[s + j] = add_mod(u, v, q->p);
+                x[s + j + h] = sub_mod(u, v, q->p);
+            }
+        }
+    }
+}
+
+static jint ntt_length(jint na, jint nb) {
+    jint n = 1;
+    while (n < na + nb - 1) {
+        n <<= 1;
+    }
+    return n;
+}
+
+// operands are big-endian, i.e. a[-i] is the limb of weight BASE^i
+static void ntt_load(uint32_t * x, jint n, const jint * a, jint na, const struct ntt_prime * q) {
+    for (jint i = 0; i < na; i++) {
+        x[i] = (uint32_t) a[-i] % q->p;
+    }
+    for (jint i = na; i < n; i++) {
+        x[i] = 0;
+    }
+}
+
+/*
+ * r = a * b with little-endian r (na + nb limbs) and big-endian operands,
+ * where a and b point to the least significant limbs.
+ * Needs 5 * ntt_length(na, nb) ints of scratch: one transform per prime,
+ * one for the second operand and one for the roots.
+ */
+static void mul_ntt(jint * r, const jint * a, jint na, const jint * b, jint nb, jint * scratch) {
+    jint n = ntt_length(na, nb);
+    ASSERT(n <= NTT_MAX_LENGTH);
+    uint32_t * x[3] = { (uint32_t *) scratch, (uint32_t *) scratch + n, (uint32_t *) scratch + 2 * n };
+    uint32_t * y = (uint32_t *) scratch + 3 * n;
+    uint32_t * roots = (uint32_t *) scratch + 4 * n;
+    struct ntt_prime q[3];
+    uint32_t scale[3];
+
+    for (int k = 0; k < 3; k++) {
+        ntt_prime_init(&q[k], NTT_PRIMES[k][0], NTT_PRIMES[k][1]);
+        ntt_roots(roots, n, /*inverse*/ 0, &q[k]);
+        ntt_load(x[k], n, a, na, &q[k]);
+        ntt_forward(x[k], n, roots, &q[k]);
+        if (b == a && nb == na) {
+            for (jint i = 0; i < n; i++) {
+                x[k][i] = mont_mul(x[k][i], x[k][i], &q[k]);
+            }
+        } else {
+            ntt_load(y, n, b, nb, &q[k]);
+            ntt_forward(y, n, roots, &q[k]);
+            for (jint i = 0; i < n; i++) {
+                x[k][i] = mont_mul(x[k][i], y[i], &q[k]);
+            }
+        }
+        ntt_roots(roots, n, /*inverse*/ 1, &q[k]);
+        ntt_inverse(x[k], n, roots, &q[k]);
+
+        // x[k] = n * c * R^-1, so we have to multiply with R^2 / n in Montgomery form
+        uint32_t n_inverse = q[k].p - (q[k].p - 1) / (uint32_t) n;
+        scale[k] = mont_mul(mont_mul(q[k].r2, q[k].r2, &q[k]), n_inverse, &q[k]); // R^3 * R^-1 / n
+    }
+
+    uint32_t p0 = q[0].p;
+    uint32_t p1 = q[1].p;
+    uint64_t p01 = (uint64_t) p0 * p1;
+    uint64_t p01_low = p01 % BASE;
+    uint64_t p01_high = p01 / BASE;
+    uint32_t p0_inverse_1 = mont_pow(mont_of(p0, &q[1]), q[1].p - 2, &q[1]); // p0^-1 mod p1
+    uint32_t p0_inverse_2 = mont_pow(mont_of(p0, &q[2]), q[2].p - 2, &q[2]); // p0^-1 mod p2
+    uint32_t p1_inverse_2 = mont_pow(mont_of(p1, &q[2]), q[2].p - 2, &q[2]); // p1^-1 mod p2
+
+    // c = x0 + p0 * x1 + p0 * p1 * x2, where x0 < p0, x1 < p1, x2 < p2
+    uint64_t carry = 0;
+    jint nr = na + nb;
+    for (jint i = 0; i < nr - 1; i++) {
+        uint32_t x0 = mont_mul(x[0][i], scale[0], &q[0]);
+        uint32_t c1 = mont_mul(x[1][i], scale[1], &q[1]);
+        uint32_t c2 = mont_mul(x[2][i], scale[2], &q[2]);
+        uint32_t x1 = mont_mul(sub_mod(c1, x0, p1), p0_inverse_1, &q[1]);
+        uint32_t x2 = mont_mul(sub_mod(mont_mul(sub_mod(c2, x0, q[2].p), p0_inverse_2, &q[2]), x1, q[2].p), p1_inverse_2, &q[2]);
+
+        uint64_t y01 = x0 + (uint64_t) p0 * x1; // < p0 * p1 < 2^60
+        uint64_t low = y01 % BASE + x2 * p01_low + carry;
+        r[i] = (jint) (low % BASE);
+        carry = y01 / BASE + x2 * p01_high + low / BASE;
+    }
+    ASSERT(carry < BASE);
+    r[nr - 1] = (jint) carry;
+}
+
+JNIEXPORT jlong JNICALL Java_philippag_lib_common_math_compint_Int9N_multiplyNttScratchLength(
+        JNIEnv * env, jclass cls,
+        jint lhsLength, jint rhsLength) {
+
+    jint n = ntt_length(lhsLength, rhsLength);
+    return n > NTT_MAX_LENGTH ? -1 : 5 * (jlong) n;
+}
+
+// same coordinates as multiplyCore(), plus a scratch buffer sized by multiplyNttScratchLength()
+JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_multiplyNttCore(
+        JNIEnv * env, jclass cls,
+        jintArray resultArray, jint resultLength, jint shift,
+        jintArray lhsArray, jint lhsOffset, jint lhsMax,
+        jintArray rhsArray, jint rhsOffset, jint rhsMax,
+        jintArray scratchArray) {
+
+    jint * lhs = (*env)->GetPrimitiveArrayCritical(env, lhsArray, /*isCopy*/ NULL);
+    jint * rhs = (*env)->GetPrimitiveArrayCritical(env, rhsArray, /*isCopy*/ NULL);
+    jint * result = (*env)->GetPrimitiveArrayCritical(env, resultArray, /*isCopy*/ NULL);
+    jint * scratch = (*env)->GetPrimitiveArrayCritical(env, scratchArray, /*isCopy*/ NULL);
+
+    ASSERT(lhs && rhs && result && scratch);
+
+    jint na = lhsMax - lhsOffset + 1;
+    jint nb = rhsMax - rhsOffset + 1;
+    jint * r = result + resultLength - shift - (na + nb) + 1;
+    ASSERT(r >= result);
+    mul_ntt(r, lhs + lhsMax, na, rhs + rhsMax, nb, scratch);
+    reverse(r, na + nb);
+
+    (*env)->ReleasePrimitiveArrayCritical(env, scratchArray, scratch, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, resultArray, result, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, rhsArray, rhs, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, lhsArray, lhs, JNI_ABORT);
+}
+
+// off-heap variant, same coordinates as multiplySubquadraticDirectCore()
+JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_multiplyNttDirectCore(
+        JNIEnv * env, jclass cls,
+        jobject buffer, jint resultIndex,
+        jint lhsIndex, jint lhsLength,
+        jint rhsIndex, jint rhsLength,
+        jint scratchIndex) {
+
+    jint * ints = (*env)->GetDirectBufferAddress(env, buffer);
+
+    ASSERT(ints);
+
+    jint * r = ints + resultIndex;
+    mul_ntt(r, ints + lhsIndex + lhsLength - 1, lhsLength, ints + rhsIndex + rhsLength - 1, rhsLength, ints + scratchIndex);
+    reverse(r, lhsLength + rhsLength);
+}
+
+/*
+ * Powers of a single limb.
+ *
+ * base^exponent from left to right, one bit of the exponent at a time: square,
+ * and multiply by the base if the bit is set, which is linear for a single limb.
+ * So there is no table of powers to keep, and the result length is known up front,
+ * the caller presizes both buffers with it and all squares run in place of them.
+ */
+
+// x *= m for little-endian x, returns the new length, x must have room for n + 1 limbs
+static jint mul_limb(jint * x, jint n, jint m) {
+    uint64_t carry = 0;
+    for (jint i = 0; i < n; i++) {
+        uint64_t value = (uint32_t) x[i] * (uint64_t) m + carry;
+        x[i] = (jint) (value % BASE);
+        carry = value / BASE;
+    }
+    if (carry != 0) {
+        x[n++] = (jint) carry;
+    }
+    return n;
+}
+
+static jint pow_use_ntt(jint n, jint nttThreshold) {
+    return n > nttThreshold && ntt_length(n, n) <= NTT_MAX_LENGTH;
+}
+
+// enough for every square up to n limbs, the longest squares may be too long for the transform
+static jlong pow_square_scratch(jint n, const struct thresholds * t, jint nttThreshold) {
+    jlong size = mul_scratch(n, t);
+    jint m = n < NTT_MAX_LENGTH / 2 ? n : NTT_MAX_LENGTH / 2;
+    if (pow_use_ntt(m, nttThreshold)) {
+        jlong ntt = m + 5 * (jlong) ntt_length(m, m); // big-endian copy for mul_ntt(), and its scratch
+        if (ntt > size) {
+            size = ntt;
+        }
+    }
+    return size;
+}
+
+// r = a^2 for little-endian a and r, r must have room for 2 * na limbs
+static void pow_square(jint * r, const jint * a, jint na, jint * scratch, const struct thresholds * t, jint nttThreshold) {
+    if (pow_use_ntt(na, nttThreshold)) {
+        reverse_copy(scratch, a, na);
+        mul_ntt(r, scratch + na - 1, na, scratch + na - 1, na, scratch + na);
+    } else {
+        mul(r, a, na, a, na, scratch, t);
+    }
+}
+
+// r = base^exponent, big-endian, zero-padded to nr limbs, for 2 <= base < BASE and exponent >= 1
+static void pow_int(jint * r, jint nr, jint base, jint exponent, jint * scratch, const struct thresholds * t, jint nttThreshold) {
+    jint * x = r;
+    jint * y = scratch; // the other nr limbs
+    jint n = 1;
+    jint bit = 30;
+    while ((exponent >> bit & 1) == 0) {
+        --bit;
+    }
+    x[0] = base;
+    while (--bit >= 0) {
+        ASSERT(2 * n <= nr);
+        pow_square(y, x, n, scratch + nr, t, nttThreshold);
+        n = trim(y, 2 * n);
+        jint * tmp = x; x = y; y = tmp;
+        if ((exponent >> bit & 1) != 0) {
+            ASSERT(n < nr);
+            n = mul_limb(x, n, base);
+        }
+    }
+    if (x != r) {
+        memcpy(r, x, n * sizeof(jint));
+    }
+    zero(r + n, nr - n);
+    reverse(r, nr);
+}
+
+JNIEXPORT jlong JNICALL Java_philippag_lib_common_math_compint_Int9N_powIntScratchLength(
+        JNIEnv * env, jclass cls,
+        jint resultLength, jint karatsubaThreshold, jint toomCook3Threshold, jint nttThreshold) {
+
+    struct thresholds t = { karatsubaThreshold, toomCook3Threshold };
+    return resultLength + pow_square_scratch(resultLength / 2, &t, nttThreshold);
+}
+
+// the result (resultLength limbs, big-endian) goes to resultIndex of the direct buffer
+JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_powIntDirectCore(
+        JNIEnv * env, jclass cls,
+        jobject buffer, jint base, jint exponent,
+        jint resultIndex, jint resultLength,
+        jint scratchIndex, jint karatsubaThreshold, jint toomCook3Threshold, jint nttThreshold) {
+
+    jint * ints = (*env)->GetDirectBufferAddress(env, buffer);
+
+    ASSERT(ints);
+    ASSERT(2 <= base && base < BASE && exponent >= 1);
+
+    struct thresholds t = { karatsubaThreshold, toomCook3Threshold };
+    pow_int(ints + resultIndex, resultLength, base, exponent, ints + scratchIndex, &t, nttThreshold);
+}
+
+/*
+ * Division, Knuth's Algorithm D (TAOCP Vol. 2, 4.3.1) in base 1E9.
+ * The divisor is normalized by a factor d so that its top limb is at least BASE / 2,
+ * then each quotient limb is estimated from the top two limbs of the remainder,
+ * which is off by at most 2, and mostly corrected before multiplying back.
+ */
+
+// q = u / v, u = u % v, with little-endian u (nu + 1 limbs of room) and v,
+// v is destroyed, its top limb must not be zero, and nu >= nv
+static void div_knuth(jint * q, jint * u, jint nu, jint * v, jint nv) {
+    ASSERT(nu >= nv && nv > 0 && v[nv - 1] != 0);
+
+    if (nv == 1) {
+        uint64_t divisor = (uint32_t) v[0];
+        uint64_t remainder = 0;
+        for (jint i = nu - 1; i >= 0; --i) {
+            uint64_t value = remainder * BASE + (uint32_t) u[i];
+            q[i] = (jint) (value / divisor);
+            remainder = value % divisor;
+        }
+        u[0] = (jint) remainder;
+        return;
+    }
+
+    uint64_t d = BASE / ((uint64_t) v[nv - 1] + 1);
+    u[nu] = 0;
+    if (d > 1) {
+        uint64_t carry = 0;
+        for (jint i = 0; i < nu; i++) {
+            uint64_t value = (uint32_t) u[i] * d + carry;
+            u[i] = (jint) (value % BASE);
+            carry = value / BASE;
+        }
+        u[nu] = (jint) carry;
+        carry = 0;
+        for (jint i = 0; i < nv; i++) {
+            uint64_t value = (uint32_t) v[i] * d + carry;
+            v[i] = (jint) (value % BASE);
+            carry = value / BASE;
+        }
+        ASSERT(carry == 0);
+    }
+    ASSERT(v[nv - 1] >= BASE / 2);
+
+    uint64_t top = (uint32_t) v[nv - 1];
+    uint64_t second = (uint32_t) v[nv - 2];
+    for (jint j = nu - nv; j >= 0; --j) {
+        jint * w = u + j;
+        uint64_t value = (uint64_t) (uint32_t) w[nv] * BASE + (uint32_t) w[nv - 1];
+        uint64_t qhat = value / top;
+        uint64_t rhat = value % top;
+        while (qhat >= BASE || qhat * second > rhat * BASE + (uint32_t) w[nv - 2]) {
+            qhat--;
+            rhat += top;
+            if (rhat >= BASE) {
+                break;
+            }
+        }
+
+        // w -= qhat * v
+        uint64_t carry = 0;
+        jint borrow = 0;
+        for (jint i = 0; i < nv; i++) {
+            uint64_t product = qhat * (uint32_t) v[i] + carry;
+            carry = product / BASE;
+            jint diff = w[i] - (jint) (product % BASE) - borrow;
+            borrow = diff < 0;
+            w[i] = borrow ? diff + BASE : diff;
+        }
+        jlong diff = (jlong) w[nv] - (jlong) carry - borrow;
+
+        if (diff < 0) {
+            // qhat was still one too big (rare), add v back
+            qhat--;
+            jint c = 0;
+            for (jint i = 0; i < nv; i++) {
+                jint sum = w[i] + v[i] + c;
+                c = sum >= BASE;
+                w[i] = c ? sum - BASE : sum;
+            }
+            diff += c;
+        }
+        ASSERT(diff == 0);
+        w[nv] = 0;
+        q[j] = (jint) qhat;
+    }
+
+    uint64_t remainder = 0;
+    for (jint i = nv - 1; i >= 0; --i) {
+        uint64_t value = remainder * BASE + (uint32_t) u[i];
+        u[i] = (jint) (value / d);
+        remainder = value % d;
+    }
+    ASSERT(remainder == 0);
+}
+
+// big-endian source with `zeroes` implicit trailing zero limbs to little-endian destination
+static void load_limbs(jint * dst, const jint * src, jint n, jint zeroes) {
+    zero(dst, zeroes);
+    reverse_copy(dst + zeroes, src, n);
+}
+
+/*
+ * quotient = lhs / rhs, remainder = lhs % rhs, for absolute values.
+ * The operands are given like for multiplyCore(), plus their count of trailing zero limbs
+ * ("trailingZeroesForm"), the quotient and remainder arrays are filled completely (big-endian).
+ * The scratch buffer needs lhsLength + rhsLength + 1 elements.
+ */
+JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_divideCore(
+        JNIEnv * env, jclass cls,
+        jintArray quotientArray, jintArray remainderArray,
+        jintArray lhsArray, jint lhsOffset, jint lhsMax, jint lhsZeroes,
+        jintArray rhsArray, jint rhsOffset, jint rhsMax, jint rhsZeroes,
+        jintArray scratchArray) {
+
+    jint * lhs = (*env)->GetPrimitiveArrayCritical(env, lhsArray, /*isCopy*/ NULL);
+    jint * rhs = (*env)->GetPrimitiveArrayCritical(env, rhsArray, /*isCopy*/ NULL);
+    jint * quotient = (*env)->GetPrimitiveArrayCritical(env, quotientArray, /*isCopy*/ NULL);
+    jint * remainder = (*env)->GetPrimitiveArrayCritical(env, remainderArray, /*isCopy*/ NULL);
+    jint * scratch = (*env)->GetPrimitiveArrayCritical(env, scratchArray, /*isCopy*/ NULL);
+
+    ASSERT(lhs && rhs && quotient && remainder && scratch);
+
+    jint nu = lhsMax - lhsOffset + 1 + lhsZeroes;
+    jint nv = rhsMax - rhsOffset + 1 + rhsZeroes;
+    jint * u = scratch;
+    jint * v = u + nu + 1;
+    load_limbs(u, lhs + lhsOffset, nu - lhsZeroes, lhsZeroes);
+    load_limbs(v, rhs + rhsOffset, nv - rhsZeroes, rhsZeroes);
+
+    div_knuth(quotient, u, nu, v, nv);
+    reverse(quotient, nu - nv + 1);
+    reverse_copy(remainder, u, nv);
+
+    (*env)->ReleasePrimitiveArrayCritical(env, scratchArray, scratch, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, remainderArray, remainder, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, quotientArray, quotient, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, rhsArray, rhs, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, lhsArray, lhs, JNI_ABORT);
+}
+
+/*
+ * Division by a single divisor d < 2^32 without hardware division (Granlund and Montgomery),
+ * the quotient of value < 2^63 is estimated as the high half of value * floor((2^64 - 1) / d),
+ * which is at most one too small.
+ */
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 uint128_t;
+
+static inline uint64_t mul_high(uint64_t a, uint64_t b) {
+    return (uint64_t) (((uint128_t) a * b) >> 64);
+}
+#else
+static inline uint64_t mul_high(uint64_t a, uint64_t b) {
+    uint64_t a0 = (uint32_t) a, a1 = a >> 32;
+    uint64_t b0 = (uint32_t) b, b1 = b >> 32;
+    uint64_t middle = a1 * b0 + (a0 * b0 >> 32);
+    uint64_t carry = (uint32_t) middle + a0 * b1;
+    return a1 * b1 + (middle >> 32) + (carry >> 32);
+}
+#endif
+
+struct reciprocal {
+    uint64_t d;
+    uint64_t m;
+};
+
+static inline struct reciprocal reciprocal_of(uint64_t d) {
+    ASSERT(d > 0 && d <= UINT32_MAX);
+    struct reciprocal r = { d, UINT64_MAX / d };
+    return r;
+}
+
+// value / d, with value < 2^63, the remainder goes to *rest
+static inline uint64_t div_reciprocal(uint64_t value, const struct reciprocal * r, uint64_t * rest) {
+    ASSERT(value >> 63 == 0);
+    uint64_t q = mul_high(value, r->m);
+    uint64_t remainder = value - q * r->d;
+    if (remainder >= r->d) {
+        q++;
+        remainder -= r->d;
+    }
+    ASSERT(remainder < r->d);
+    *rest = remainder;
+    return q;
+}
+
+// BASE^e % d
+static uint64_t pow_base_mod(jint e, const struct reciprocal * r) {
+    uint64_t result = 1 % r->d;
+    uint64_t x = BASE % r->d;
+    for (; e > 0; e >>= 1) {
+        if (e & 1) {
+            div_reciprocal(result * x, r, &result);
+        }
+        div_reciprocal(x * x, r, &x);
+    }
+    return result;
+}
+
+/*
+ * Divides lhs[lhsOffset..lhsMax] (big-endian) in-place by 0 < divisor <= 2^31,
+ * returns the remainder.
+ */
+JNIEXPORT jlong JNICALL Java_philippag_lib_common_math_compint_Int9N_divideIntCore(
+        JNIEnv * env, jclass cls,
+        jintArray lhsArray, jint lhsOffset, jint lhsMax, jlong divisor) {
+
+    jint * lhs = (*env)->GetPrimitiveArrayCritical(env, lhsArray, /*isCopy*/ NULL);
+
+    ASSERT(lhs);
+
+    struct reciprocal r = reciprocal_of((uint64_t) divisor);
+    uint64_t remainder = 0;
+    for (jint i = lhsOffset; i <= lhsMax; i++) {
+        lhs[i] = (jint) div_reciprocal(remainder * BASE + (uint32_t) lhs[i], &r, &remainder);
+    }
+
+    (*env)->ReleasePrimitiveArrayCritical(env, lhsArray, lhs, JNI_ABORT);
+    return (jlong) remainder;
+}
+
+// POWER10_INV[i] and POWER10_SHR[i] divide by 10^(8 - i), same as Int9N.DivMulTable
+static const uint64_t POWER10_INV[] = {
+    0x55e63b89, 0x6b5fca6b, 0x431bde83, 0x14f8b589, 0x68db8bad, 0x10624dd3, 0x51eb851f, 0x66666667, 1,
+};
+static const int POWER10_SHR[] = {
+    57, 54, 50, 45, 44, 38, 37, 34, 0,
+};
+static const uint32_t POWER10[] = {
+    100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1,
+};
+
+/*
+ * Moves the decimal digits of data[from..to) (big-endian) by 0 < |digits| < 9,
+ * to the left if digits > 0, returns the digits pushed out of data[from] (left)
+ * or data[to - 1] (right).
+ */
+JNIEXPORT jint JNICALL Java_philippag_lib_common_math_compint_Int9N_shiftDigitsCore(
+        JNIEnv * env, jclass cls,
+        jintArray dataArray, jint from, jint to, jint digits) {
+
+    ASSERT(digits != 0 && digits > -9 && digits < 9);
+
+    jint * data = (*env)->GetPrimitiveArrayCritical(env, dataArray, /*isCopy*/ NULL);
+
+    ASSERT(data);
+
+    uint32_t carry = 0;
+    if (digits > 0) {
+        int idx = digits - 1;
+        uint64_t inv = POWER10_INV[idx], divisor = POWER10[idx], scale = POWER10[8 - digits];
+        int shr = POWER10_SHR[idx];
+        for (jint i = to - 1; i >= from; --i) {
+            uint64_t value = (uint32_t) data[i];
+            uint64_t high = value * inv >> shr;
+            data[i] = (jint) ((value - high * divisor) * scale + carry);
+            carry = (uint32_t) high;
+        }
+    } else {
+        int idx = 8 + digits;
+        uint64_t inv = POWER10_INV[idx], divisor = POWER10[idx], scale = POWER10[-digits - 1];
+        int shr = POWER10_SHR[idx];
+        for (jint i = from; i < to; i++) {
+            uint64_t value = (uint32_t) data[i];
+            uint64_t high = value * inv >> shr;
+            data[i] = (jint) (high + carry * scale);
+            carry = (uint32_t) (value - high * divisor);
+        }
+    }
+
+    (*env)->ReleasePrimitiveArrayCritical(env, dataArray, data, JNI_ABORT);
+    return (jint) carry;
+}
+
+#define MODULO_GROUP 4
+
+/*
+ * remainders[i] = lhs % |divisors[i]|, for non-zero divisors,
+ * the operand is given like for divideCore(). Every pass over the limbs serves
+ * MODULO_GROUP divisors, whose independent dependency chains overlap in the pipeline.
+ */
+JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_moduloIntsCore(
+        JNIEnv * env, jclass cls,
+        jintArray lhsArray, jint lhsOffset, jint lhsMax, jint lhsZeroes,
+        jintArray divisorsArray, jintArray remaindersArray) {
+
+    jint count = (*env)->GetArrayLength(env, divisorsArray);
+    jint * lhs = (*env)->GetPrimitiveArrayCritical(env, lhsArray, /*isCopy*/ NULL);
+    jint * divisors = (*env)->GetPrimitiveArrayCritical(env, divisorsArray, /*isCopy*/ NULL);
+    jint * remainders = (*env)->GetPrimitiveArrayCritical(env, remaindersArray, /*isCopy*/ NULL);
+
+    ASSERT(lhs && divisors && remainders);
+
+    for (jint from = 0; from < count; from += MODULO_GROUP) {
+        jint n = count - from < MODULO_GROUP ? count - from : MODULO_GROUP;
+        struct reciprocal r[MODULO_GROUP];
+        uint64_t rest[MODULO_GROUP] = { 0 };
+        for (jint k = 0; k < n; k++) {
+            jlong d = divisors[from + k];
+            r[k] = reciprocal_of((uint64_t) (d < 0 ? -d : d));
+        }
+        for (jint i = lhsOffset; i <= lhsMax; i++) {
+            for (jint k = 0; k < n; k++) {
+                div_reciprocal(rest[k] * BASE + (uint32_t) lhs[i], &r[k], &rest[k]);
+            }
+        }
+        for (jint k = 0; k < n; k++) {
+            if (lhsZeroes > 0) {
+                div_reciprocal(rest[k] * pow_base_mod(lhsZeroes, &r[k]), &r[k], &rest[k]);
+            }
+            remainders[from + k] = (jint) rest[k];
+        }
+    }
+
+    (*env)->ReleasePrimitiveArrayCritical(env, remaindersArray, remainders, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, divisorsArray, divisors, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, lhsArray, lhs, JNI_ABORT);
+}
+
+/*
+ * Montgomery arithmetic modulo m of n limbs, coprime to BASE (odd and not divisible by 5),
+ * with R = BASE^n: a * b / R mod m needs no division by m, but n multiples q * m, where each
+ * q = -t / m mod BASE makes the lowest limb of the sum t vanish, so that it can be shifted out.
+ *
+ * The sum is kept in 64-bit column accumulators, as in long multiplication, and carried
+ * every TILE_ROWS rows only: a row q * m leaves the limb t[i] divisible by BASE without
+ * touching the limbs above, whose carries don't change t[i] mod BASE.
+ * Up to the Karatsuba threshold, mod_mul() adds the rows a[i] * b in the same pass ("fused"),
+ * above, the product comes from mul() and only the reduction rows are added.
+ */
+
+struct modulus {
+    const jint * m; // little-endian, m[n - 1] != 0
+    jint n;
+    uint32_t inverse; // -1 / m mod BASE
+    const uint32_t * padded; // m for mul_rows(), see mod_init()
+};
+
+// scratch of mod_mul(): the accumulators (8 byte aligned), b for mul_rows(), the product and scratch of mul()
+static jlong mod_mul_scratch(jint n, const struct thresholds * t) {
+    jlong size = 2 * (2 * (jlong) n + 1 + TILE_PAD) + 1 + n + 2 * TILE_PAD;
+    if (n > t->karatsuba) {
+        size += 2 * (jlong) n + mul_scratch(n, t);
+    }
+    return size;
+}
+
+// takes n + 2 * TILE_PAD limbs of scratch for the padded copy of m, returns the rest
+static jint * mod_init(struct modulus * p, const jint * m, jint n, jint inverse, jint * scratch) {
+    ASSERT(n > 0 && m[n - 1] != 0 && (m[0] & 1) != 0 && m[0] % 5 != 0);
+    ASSERT((uint32_t) (inverse * (int64_t) m[0] % BASE) == BASE - 1);
+    p->m = m;
+    p->n = n;
+    p->inverse = (uint32_t) inverse;
+    p->padded = tile_copy((uint32_t *) scratch, m, 1, n);
+    return scratch + n + 2 * TILE_PAD;
+}
+
+// r = a * b / R mod m for a, b < m of n limbs, r may alias a or b, squares are detected by a == b
+static void mod_mul(jint * r, const jint * a, const jint * b, const struct modulus * p, jint * scratch, const struct thresholds * t) {
+    jint n = p->n;
+    jint fused = n <= t->karatsuba;
+    uint64_t * acc = (uint64_t *) (((uintptr_t) scratch + 7) & ~(uintptr_t) 7);
+    jint * rest = scratch + 2 * (2 * n + 1 + TILE_PAD) + 1;
+    uint32_t * bp = NULL;
+
+    if (fused) {
+        bp = tile_copy((uint32_t *) rest, b, 1, n);
+        for (jint k = 0; k < 2 * n + 1 + TILE_PAD; k++) {
+            acc[k] = 0;
+        }
+    } else {
+        jint * product = rest + n + 2 * TILE_PAD;
+        mul(product, a, n, b, n, product + 2 * n, t);
+        for (jint k = 0; k < 2 * n; k++) {
+            acc[k] = (uint32_t) product[k];
+        }
+        for (jint k = 2 * n; k < 2 * n + 1 + TILE_PAD; k++) {
+            acc[k] = 0;
+        }
+    }
+
+    jint rows = 0;
+    for (jint i = 0; i < n; i++) {
+        if (fused) {
+            uint32_t ai = (uint32_t) a[i];
+            mul_rows(acc + i, bp, n, &ai, 1);
+            rows++;
+        }
+        uint32_t q = (uint32_t) (acc[i] % BASE * p->inverse % BASE);
+        mul_rows(acc + i, p->padded, n, &q, 1);
+        rows++;
+        ASSERT(acc[i] % BASE == 0);
+        acc[i + 1] += acc[i] / BASE;
+        if (rows + 2 > TILE_ROWS) {
+            normalize(acc, i + 1, i + n + 1, 2 * n + 1);
+            rows = 0;
+        }
+    }
+    normalize(acc, n, 2 * n + 1, 2 * n + 1);
+
+    // acc[n, 2n] < 2m, subtract m once if needed
+    const jint * m = p->m;
+    jint k = n - 1;
+    while (k >= 0 && acc[n + k] == (uint32_t) m[k]) {
+        --k;
+    }
+    jint reduce = acc[2 * n] != 0 || k < 0 || acc[n + k] > (uint32_t) m[k];
+    jint borrow = 0;
+    for (k = 0; k < n; k++) {
+        jint diff = (jint) acc[n + k] - (reduce ? m[k] : 0) - borrow;
+        borrow = diff < 0;
+        r[k] = borrow ? diff + BASE : diff;
+    }
+    ASSERT(borrow == (jint) acc[2 * n]);
+}
+
+// r = a^e mod m for a < m and e > 0, given as big-endian bytes, sliding window over the odd powers up to a^(2^windowBits - 1)
+static void mod_pow(jint * r, const jint * a, const jbyte * e, jint ne, const struct modulus * p, const jint * r2,
+        jint windowBits, jint * scratch, const struct thresholds * t) {
+    jint n = p->n;
+    jint * powers = scratch; // a, a^3, a^5, ... times R
+    jint * x = powers + ((jlong) n << (windowBits - 1));
+    jint * y = x + n;
+    scratch = y + n;
+
+    mod_mul(powers, a, r2, p, scratch, t);
+    if (windowBits > 1) {
+        mod_mul(y, powers, powers, p, scratch, t);
+        for (jint i = 1; i < 1 << (windowBits - 1); i++) {
+            mod_mul(powers + i * n, powers + (i - 1) * n, y, p, scratch, t);
+        }
+    }
+
+    while (ne > 0 && e[0] == 0) {
+        e++;
+        ne--;
+    }
+    ASSERT(ne > 0);
+    #define EXPONENT_BIT(i) ((uint8_t) e[ne - 1 - ((i) >> 3)] >> ((i) & 7) & 1)
+    jint started = 0;
+    jlong bit = 8 * (jlong) ne - 1;
+    while (EXPONENT_BIT(bit) == 0) {
+        --bit;
+    }
+    while (bit >= 0) {
+        if (EXPONENT_BIT(bit) == 0) {
+            mod_mul(x, x, x, p, scratch, t);
+            --bit;
+            continue;
+        }
+        // the longest window of at most windowBits bits from here, ending with a set bit
+        jlong low = bit - windowBits + 1 > 0 ? bit - windowBits + 1 : 0;
+        while (EXPONENT_BIT(low) == 0) {
+            ++low;
+        }
+        jint window = 0;
+        for (jlong i = bit; i >= low; --i) {
+            window = window << 1 | EXPONENT_BIT(i);
+        }
+        const jint * power = powers + (window >> 1) * n;
+        if (!started) {
+            memcpy(x, power, n * sizeof(jint));
+            started = 1;
+        } else {
+            for (jlong i = low; i <= bit; i++) {
+                mod_mul(x, x, x, p, scratch, t);
+            }
+            mod_mul(x, x, power, p, scratch, t);
+        }
+        bit = low - 1;
+    }
+    #undef EXPONENT_BIT
+
+    // out of Montgomery form: times 1 / R
+    zero(y, n);
+    y[0] = 1;
+    mod_mul(r, x, y, p, scratch, t);
+}
+
+JNIEXPORT jlong JNICALL Java_philippag_lib_common_math_compint_Int9N_modMultiplyScratchLength(
+        JNIEnv * env, jclass cls,
+        jint modulusLength, jint windowBits, jint karatsubaThreshold, jint toomCook3Threshold) {
+
+    struct thresholds t = { karatsubaThreshold, toomCook3Threshold };
+    jlong powers = windowBits > 0 ? (((jlong) 1 << (windowBits - 1)) + 2) * modulusLength : 0;
+    return modulusLength + 2 * TILE_PAD + powers + mod_mul_scratch(modulusLength, &t);
+}
+
+/*
+ * result = lhs * rhs mod m: the Montgomery product, times R^2 mod m (r2) in another one,
+ * or just lhs * rhs / R mod m if r2 is null, for operands kept in Montgomery form.
+ * All arrays are little-endian limbs of the modulus' length, the operands below `modulus`,
+ * `inverse` is -1 / modulus mod BASE, and scratch is sized by modMultiplyScratchLength() with 0 window bits.
+ * A square passes the same array as both operands, and result may be the same array as either.
+ */
+JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_modMultiplyCore(
+        JNIEnv * env, jclass cls,
+        jintArray resultArray, jintArray lhsArray, jintArray rhsArray,
+        jintArray modulusArray, jint inverse, jintArray r2Array,
+        jintArray scratchArray, jint karatsubaThreshold, jint toomCook3Threshold) {
+
+    jint n = (*env)->GetArrayLength(env, modulusArray);
+    jboolean square = (*env)->IsSameObject(env, lhsArray, rhsArray);
+    jboolean inLhs = (*env)->IsSameObject(env, resultArray, lhsArray);
+    jboolean inRhs = !inLhs && (*env)->IsSameObject(env, resultArray, rhsArray);
+    jint * lhs = (*env)->GetPrimitiveArrayCritical(env, lhsArray, /*isCopy*/ NULL);
+    jint * rhs = square ? lhs : (*env)->GetPrimitiveArrayCritical(env, rhsArray, /*isCopy*/ NULL);
+    jint * modulus = (*env)->GetPrimitiveArrayCritical(env, modulusArray, /*isCopy*/ NULL);
+    jint * r2 = r2Array ? (*env)->GetPrimitiveArrayCritical(env, r2Array, /*isCopy*/ NULL) : NULL;
+    jint * result = inLhs ? lhs : inRhs ? rhs : (*env)->GetPrimitiveArrayCritical(env, resultArray, /*isCopy*/ NULL);
+    jint * scratch = (*env)->GetPrimitiveArrayCritical(env, scratchArray, /*isCopy*/ NULL);
+
+    ASSERT(lhs && rhs && modulus && (r2 || !r2Array) && result && scratch);
+
+    struct thresholds t = { karatsubaThreshold, toomCook3Threshold };
+    struct modulus p;
+    jint * rest = mod_init(&p, modulus, n, inverse, scratch);
+    mod_mul(result, lhs, rhs, &p, rest, &t);
+    if (r2) {
+        mod_mul(result, result, r2, &p, rest, &t);
+    }
+
+    (*env)->ReleasePrimitiveArrayCritical(env, scratchArray, scratch, JNI_ABORT);
+    if (!inLhs && !inRhs) {
+        (*env)->ReleasePrimitiveArrayCritical(env, resultArray, result, JNI_ABORT);
+    }
+    if (r2) {
+        (*env)->ReleasePrimitiveArrayCritical(env, r2Array, r2, JNI_ABORT);
+    }
+    (*env)->ReleasePrimitiveArrayCritical(env, modulusArray, modulus, JNI_ABORT);
+    if (!square) {
+        (*env)->ReleasePrimitiveArrayCritical(env, rhsArray, rhs, JNI_ABORT);
+    }
+    (*env)->ReleasePrimitiveArrayCritical(env, lhsArray, lhs, JNI_ABORT);
+}
+
+// result = base^exponent mod m, with the same conventions as modMultiplyCore(), for a positive exponent (big-endian bytes)
+JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_modPowCore(
+        JNIEnv * env, jclass cls,
+        jintArray resultArray, jintArray baseArray, jbyteArray exponentArray,
+        jintArray modulusArray, jint inverse, jintArray r2Array, jint windowBits,
+        jintArray scratchArray, jint karatsubaThreshold, jint toomCook3Threshold) {
+
+    jint n = (*env)->GetArrayLength(env, modulusArray);
+    jint ne = (*env)->GetArrayLength(env, exponentArray);
+    jint * base = (*env)->GetPrimitiveArrayCritical(env, baseArray, /*isCopy*/ NULL);
+    jbyte * exponent = (*env)->GetPrimitiveArrayCritical(env, exponentArray, /*isCopy*/ NULL);
+    jint * modulus = (*env)->GetPrimitiveArrayCritical(env, modulusArray, /*isCopy*/ NULL);
+    jint * r2 = (*env)->GetPrimitiveArrayCritical(env, r2Array, /*isCopy*/ NULL);
+    jint * result = (*env)->GetPrimitiveArrayCritical(env, resultArray, /*isCopy*/ NULL);
+    jint * scratch = (*env)->GetPrimitiveArrayCritical(env, scratchArray, /*isCopy*/ NULL);
+
+    ASSERT(base && exponent && modulus && r2 && result && scratch);
+
+    struct thresholds t = { karatsubaThreshold, toomCook3Threshold };
+    struct modulus p;
+    jint * rest = mod_init(&p, modulus, n, inverse, scratch);
+    mod_pow(result, base, exponent, ne, &p, r2, windowBits, rest, &t);
+
+    (*env)->ReleasePrimitiveArrayCritical(env, scratchArray, scratch, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, resultArray, result, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, r2Array, r2, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, modulusArray, modulus, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, exponentArray, exponent, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, baseArray, base, JNI_ABORT);
+}
+
+/*
+ * Conversion between ASCII digits and base 1E9 limbs, 9 digits per limb.
+ *
+ * Parsing combines the digits pairwise by multiply-adds: 16 digits become 8 numbers of 2 digits,
+ * then 4 of 4 digits, then 2 of 8 digits. A limb's 16-byte window ends with its 9 digits,
+ * the 7 bytes before those (the previous limb's digits, or the sign) are masked out.
+ *
+ * Formatting multiplies the limb by 2^60 / 1E8 (rounded up), which puts the leading digit into
+ * the top 4 bits, and every multiplication of the remaining fraction by 10 brings up the next one.
+ * The rounding error (below 2^30) grows by a factor of 10 per digit, and stays below
+ * the distance of the fraction to the next digit (at least 2^60 / 1E8) for all 9 of them.
+ */
+
+#define FORMAT_SHIFT 60
+#define FORMAT_FACTOR 11529215047ULL // ceil(2^60 / 1E8) = 2 * 2^32 + 2939280455
+
+// r[i] = the 9 digits at s[9 * i, 9 * (i + 1)) for 0 <= i < n, returns false if there's a non-digit
+// the window of a limb starts 7 bytes before its digits, so s[-7, 0) must be readable as well
+typedef jboolean (* parse_fn)(jint * r, const jbyte * s, jint n);
+
+// s[9 * i, 9 * (i + 1)) = the 9 digits of a[i] for 0 <= i < n
+typedef void (* format_fn)(jbyte * s, const jint * a, jint n);
+
+// the `n` digits at s, `bad` is set if there's a non-digit
+static jint parse_digits(const jbyte * s, jint n, jint * bad) {
+    uint32_t value = 0;
+    for (jint j = 0; j < n; j++) {
+        uint32_t digit = (uint32_t) (s[j] - '0');
+        *bad |= digit > 9;
+        value = value * 10 + digit;
+    }
+    return (jint) value;
+}
+
+static jboolean parse_scalar(jint * r, const jbyte * s, jint n) {
+    jint bad = 0;
+    for (jint i = 0; i < n; i++) {
+        r[i] = parse_digits(s + 9 * i, 9, &bad);
+    }
+    return !bad;
+}
+
+static void format_scalar(jbyte * s, const jint * a, jint n) {
+    for (jint i = 0; i < n; i++, s += 9) {
+        uint64_t t = (uint32_t) a[i] * FORMAT_FACTOR;
+        for (jint j = 0; j < 9; j++) {
+            s[j] = (jbyte) ('0' + (t >> FORMAT_SHIFT));
+            t = (t & ((1ULL << FORMAT_SHIFT) - 1)) * 10;
+        }
+    }
+}
+
+#ifdef _USE_X86_SIMD
+// two limbs per step, one in each 128-bit lane
+__attribute__((target("avx2")))
+static jboolean parse_avx2(jint * r, const jbyte * s, jint n) {
+    const __m256i zero = _mm256_set1_epi8('0');
+    const __m256i nine = _mm256_set1_epi8(9);
+    const __m256i window = _mm256_setr_epi8(
+            0, 0, 0, 0, 0, 0, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            0, 0, 0, 0, 0, 0, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i tens = _mm256_set1_epi16(1 << 8 | 10); // (10, 1) as bytes
+    const __m256i hundreds = _mm256_set1_epi32(1 << 16 | 100); // (100, 1) as 16-bit words
+    const __m256i tenThousands = _mm256_set1_epi32(1 << 16 | 10000);
+    const __m256i hundredMillions = _mm256_set1_epi64x(100000000);
+    jint bad = 0;
+    jint i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i lo = _mm_loadu_si128((const __m128i *) (s + 9 * i - 7));
+        __m128i hi = _mm_loadu_si128((const __m128i *) (s + 9 * i + 2));
+        __m256i v = _mm256_sub_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), zero);
+        __m256i digit = _mm256_cmpeq_epi8(_mm256_max_epu8(v, nine), nine); // unsigned: v <= 9
+        bad |= (~(uint32_t) _mm256_movemask_epi8(digit) & 0xFF80FF80u) != 0;
+        v = _mm256_and_si256(v, window);
+        v = _mm256_maddubs_epi16(v, tens); // 8 numbers of 2 digits per lane
+        v = _mm256_madd_epi16(v, hundreds); // 4 of 4 digits
+        v = _mm256_packus_epi32(v, v);
+        v = _mm256_madd_epi16(v, tenThousands); // 2 of 8 digits, the first of which has only one
+        v = _mm256_add_epi64(_mm256_mul_epu32(v, hundredMillions), _mm256_srli_epi64(v, 32));
+        r[i] = _mm256_extract_epi32(v, 0);
+        r[i + 1] = _mm256_extract_epi32(v, 4);
+    }
+    return parse_scalar(r + i, s + 9 * i, n - i) && !bad;
+}
+
+// four limbs per step, one in each 64-bit lane
+__attribute__((target("avx2")))
+static void format_avx2(jbyte * s, const jint * a, jint n) {
+    const __m256i factor = _mm256_set1_epi64x(FORMAT_FACTOR & 0xFFFFFFFF);
+    const __m256i fraction = _mm256_set1_epi64x((1LL << FORMAT_SHIFT) - 1);
+    const __m256i zero = _mm256_set1_epi64x('0');
+    jint i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *) (a + i)));
+        __m256i t = _mm256_add_epi64(_mm256_mul_epu32(x, factor), _mm256_slli_epi64(x, 33));
+        __m256i digits = _mm256_setzero_si256(); // the first 8 digits, one per byte
+        for (int j = 0; j < 8; j++) {
+            __m256i digit = _mm256_add_epi64(_mm256_srli_epi64(t, FORMAT_SHIFT), zero);
+            digits = _mm256_or_si256(digits, _mm256_sll_epi64(digit, _mm_cvtsi32_si128(8 * j)));
+            t = _mm256_and_si256(t, fraction);
+            t = _mm256_add_epi64(_mm256_slli_epi64(t, 3), _mm256_slli_epi64(t, 1));
+        }
+        __m256i last = _mm256_add_epi64(_mm256_srli_epi64(t, FORMAT_SHIFT), zero);
+        uint64_t head[4];
+        uint64_t tail[4];
+        _mm256_storeu_si256((__m256i *) head, digits);
+        _mm256_storeu_si256((__m256i *) tail, last);
+        for (int k = 0; k < 4; k++) {
+            memcpy(s + 9 * (i + k), &head[k], 8); // x86 is little-endian: the first digit is the lowest byte
+            s[9 * (i + k) + 8] = (jbyte) tail[k];
+        }
+    }
+    format_scalar(s + 9 * i, a + i, n - i);
+}
+#endif
+
+static parse_fn parse = parse_scalar;
+static format_fn format = format_scalar;
+
+// the digits at ascii[fromIndex, toIndex) to result[0, (toIndex - fromIndex + 8) / 9), big-endian
+static jboolean parse_ascii(jint * result, const jbyte * ascii, jint fromIndex, jint toIndex) {
+    jint n = (toIndex - fromIndex + 8) / 9;
+    jint first = toIndex - fromIndex - 9 * (n - 1); // digits of the leading limb
+    jint bad = 0;
+    result[0] = parse_digits(ascii + fromIndex, first, &bad);
+
+    // the full limbs, those whose window would start before ascii[0] are parsed one by one
+    const jbyte * s = ascii + fromIndex + first;
+    jint i = 1;
+    for (; i < n && fromIndex + first + 9 * (i - 1) < 7; i++) {
+        result[i] = parse_digits(s + 9 * (i - 1), 9, &bad);
+    }
+    return !bad && (i == n || parse(result + i, s + 9 * (i - 1), n - i));
+}
+
+JNIEXPORT jboolean JNICALL Java_philippag_lib_common_math_compint_Int9N_parseCore(
+        JNIEnv * env, jclass cls,
+        jbyteArray asciiArray, jint fromIndex, jint toIndex, jintArray resultArray) {
+
+    jbyte * ascii = (*env)->GetPrimitiveArrayCritical(env, asciiArray, /*isCopy*/ NULL);
+    jint * result = (*env)->GetPrimitiveArrayCritical(env, resultArray, /*isCopy*/ NULL);
+
+    ASSERT(ascii && result);
+
+    jboolean valid = parse_ascii(result, ascii, fromIndex, toIndex);
+
+    (*env)->ReleasePrimitiveArrayCritical(env, resultArray, result, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, asciiArray, ascii, JNI_ABORT);
+    return valid;
+}
+
+// like parseCore(), on a direct buffer, e.g. a mapped file
+JNIEXPORT jboolean JNICALL Java_philippag_lib_common_math_compint_Int9N_parseDirectCore(
+        JNIEnv * env, jclass cls,
+        jobject buffer, jint fromIndex, jint toIndex, jintArray resultArray) {
+
+    jbyte * ascii = (*env)->GetDirectBufferAddress(env, buffer);
+    jint * result = (*env)->GetPrimitiveArrayCritical(env, resultArray, /*isCopy*/ NULL);
+
+    ASSERT(ascii && result);
+
+    jboolean valid = parse_ascii(result, ascii, fromIndex, toIndex);
+
+    (*env)->ReleasePrimitiveArrayCritical(env, resultArray, result, JNI_ABORT);
+    return valid;
+}
+
+// data[from, to) to 9 digits each at dest[destOffset, destOffset + 9 * (to - from))
+JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_formatCore(
+        JNIEnv * env, jclass cls,
+        jintArray dataArray, jint from, jint to, jbyteArray destArray, jint destOffset) {
+
+    jint * data = (*env)->GetPrimitiveArrayCritical(env, dataArray, /*isCopy*/ NULL);
+    jbyte * dest = (*env)->GetPrimitiveArrayCritical(env, destArray, /*isCopy*/ NULL);
+
+    ASSERT(data && dest);
+
+    format(dest + destOffset, data + from, to - from);
+
+    (*env)->ReleasePrimitiveArrayCritical(env, destArray, dest, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, dataArray, data, JNI_ABORT);
+}
+
+// like formatCore(), to a direct buffer
+JNIEXPORT void JNICALL Java_philippag_lib_common_math_compint_Int9N_formatDirectCore(
+        JNIEnv * env, jclass cls,
+        jintArray dataArray, jint from, jint to, jobject buffer, jint destOffset) {
+
+    jint * data = (*env)->GetPrimitiveArrayCritical(env, dataArray, /*isCopy*/ NULL);
+    jbyte * dest = (*env)->GetDirectBufferAddress(env, buffer);
+
+    ASSERT(data && dest);
+
+    format(dest + destOffset, data + from, to - from);
+
+    (*env)->ReleasePrimitiveArrayCritical(env, dataArray, data, JNI_ABORT);
+}
+
+/*
+ * Plain C entry points for java.lang.foreign downcalls, see Int9N.Foreign.
+ * They take the same coordinates as their JNI counterparts, but raw pointers:
+ * the Java side hands its arrays to "critical" downcalls, which keep them in place
+ * for the duration of the call, so neither JNIEnv nor pinning is involved.
+ */
+
+JNIEXPORT void int9_multiply(
+        jint * result, jint resultLength, jint shift,
+        const jint * lhs, jint lhsOffset, jint lhsMax,
+        const jint * rhs, jint rhsOffset, jint rhsMax) {
+
+    mul_tiles(result + resultLength - shift, -1,
+            lhs + lhsMax, lhsMax - lhsOffset + 1,
+            rhs + rhsMax, rhsMax - rhsOffset + 1);
+}
+
+JNIEXPORT void int9_multiply_columns(
+        jint * result, jint resultLength, jint shift,
+        const jint * lhs, jint lhsOffset, jint lhsMax,
+        const jint * rhs, jint rhsOffset, jint rhsMax) {
+
+    mul_columns(result + resultLength - shift, -1,
+            lhs + lhsMax, lhsMax - lhsOffset + 1,
+            rhs + rhsMax, rhsMax - rhsOffset + 1);
+}
+
+JNIEXPORT void int9_square(
+        jint * result, jint resultLength, jint shift,
+        const jint * lhs, jint lhsOffset, jint lhsMax) {
+
+    sqr_tiles(result + resultLength - shift, -1, lhs + lhsMax, lhsMax - lhsOffset + 1);
+}
+
+// picks the long multiplication kernel once, when the library is loaded
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM * vm, void * reserved) {
+#ifdef _USE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        mul_rows = mul_rows_avx512;
+    } else if (__builtin_cpu_supports("avx2")) {
+        mul_rows = mul_rows_avx2;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        add_n = add_n_avx2;
+        sub_n = sub_n_avx2;
+        parse = parse_avx2;
+        format = format_avx2;
+    }
+#endif
+    return JNI_VERSION_1_8;
+}
@@ -1,11 +1,32 @@
 package philippag.lib.common.math.compint;
 
 import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.lang.foreign.Arena;
+import java.lang.management.ManagementFactory;
 import java.math.BigInteger;
+import java.nio.BufferOverflowException;
+import java.nio.BufferUnderflowException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.channels.Pipe;
 import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.StandardOpenOption;
+import java.util.ArrayList;
+import java.util.HashSet;
+import java.util.List;
 import java.util.Random;
+import java.util.Set;
 import java.util.concurrent.ForkJoinPool;
+import java.util.function.BinaryOperator;
+import java.util.function.IntFunction;
 import java.util.function.Supplier;
+import java.util.stream.Stream;
+
+import javax.management.Attribute;
+import javax.management.JMException;
+import javax.management.ObjectName;
 
 import org.junit.AfterClass;
 import org.junit.Assert;
@@ -16,6 +37,7 @@
 
 import philippag.lib.common.math.CommonTestBase;
 import philippag.lib.common.math.compint.AsciiDigits.AsciiDigitArraySink;
+import philippag.lib.common.math.compint.AsciiDigits.ChunkedSink;
 
 public class Int9NTest extends CommonTestBase {
 
@@ -381,6 +403,111 @@ private static void checkCharAt0(String str) {
         Assert.assertTrue(stringsEqual(str, x));
     }
 
+    @Test
+    public void getDigits() {
+        var rnd = new Random();
+        String[] inputs = {
+                "0", "7", "123456789", "1234567890", "-9223372036854775808", "1" + "0".repeat(100),
+                randomNumericString(rnd, 10, 100), "-" + randomNumericString(rnd, 1_000, 2_000) + "0".repeat(random(rnd, 1, 500)),
+        };
+        for (String str : inputs) {
+            var x = Int9N.fromString(str);
+            String digits = str.replace("-", "");
+            int n = digits.length();
+            for (int i = 0; i < 200; i++) {
+                int from = n < 30 ? i % n : random(rnd, 0, n - 1);
+                int len = n < 30 ? (i / n) % (n - from + 1) : random(rnd, 0, n - from);
+                int off = random(rnd, 0, 3);
+                byte[] dst = new byte[off + len + 2];
+                x.getDigits(from, dst, off, len);
+                Assert.assertEquals(digits.substring(from, from + len), new String(dst, off, len, StandardCharsets.ISO_8859_1));
+                Assert.assertEquals(0, dst[off + len]);
+
+                int start = random(rnd, 0, str.length() - 1);
+                int end = random(rnd, start + 1, str.length());
+                String expected = str.substring(start, end);
+                if (!expected.equals("-")) {
+                    Assert.assertEquals(new BigInteger(expected).toString(), x.subSequence(start, end).toString());
+                }
+            }
+            Assert.assertEquals(str, x.toString()); // not modified
+        }
+        var x = Int9N.fromString("999999999");
+        Assert.assertEquals('9', x.charAt(8));
+        x.incrementInPlace(); // leading limb changes, so does its digit count
+        Assert.assertEquals(10, x.length());
+        Assert.assertEquals('0', x.charAt(9));
+        checkStringRepresentation("1000000000", x);
+        try {
+            x.getDigits(5, new byte[10], 0, 6);
+            Assert.fail("Expecting IndexOutOfBoundsException");
+        } catch (IndexOutOfBoundsException e) {
+            System.out.println(e);
+        }
+        try {
+            x.getDigits(0, new byte[10], 5, 6);
+            Assert.fail("Expecting IndexOutOfBoundsException");
+        } catch (IndexOutOfBoundsException e) {
+            System.out.println(e);
+        }
+    }
+
+    @Test
+    public void shiftDecimal() {
+        var rnd = new Random();
+        String[] inputs = {
+                "1", "-7", "999999999", "123456789012345678", "1E30", "-5E100",
+                randomNumericString(rnd, 10, 100), "-" + randomNumericString(rnd, 1_000, 2_000) + "0".repeat(random(rnd, 1, 500)),
+        };
+        for (String str : inputs) {
+            IntFunction<Int9N> parse = shift -> (str.contains("E") ? Int9N.fromScientific(str) : Int9N.fromString(str)).shiftDecimalLeft(shift);
+            var x = parse.apply(0);
+            var expected = x.toBigInteger();
+            for (int i = 0; i < 100; i++) {
+                int digits = random(rnd, 0, 40);
+                if (rnd.nextBoolean() || expected.signum() == 0) {
+                    x.shiftDecimalLeft(digits);
+                    expected = expected.multiply(BigInteger.TEN.pow(digits));
+                } else {
+                    x.shiftDecimalRight(digits);
+                    expected = expected.divide(BigInteger.TEN.pow(digits));
+                }
+                Assert.assertEquals(expected.toString(), x.toString());
+                if (expected.signum() == 0) {
+                    break;
+                }
+            }
+            var y = parse.apply(13); // in "trailingZeroesForm"
+            Assert.assertFalse(y.halfInPlace());
+            Assert.assertEquals(parse.apply(0).toBigInteger().multiply(BigInteger.TEN.pow(13)).shiftRight(1), y.toBigInteger());
+        }
+        // halving moves the offset past the leading limb, then shifting whole limbs makes it "trailingZeroesForm"
+        var shifted = Int9N.fromString("1000000001");
+        Assert.assertTrue(shifted.halfInPlace());
+        shifted.shiftDecimalLeft(18);
+        checkStringRepresentation("1500000000" + "0".repeat(18), Int9N.multiplyRussianPeasant(Int9N.fromInt(3), shifted));
+        checkStringRepresentation("500000000" + "0".repeat(18), shifted);
+        checkStringRepresentation("0", Int9N.fromString("-123456789").shiftDecimalRight(9));
+        checkStringRepresentation("0", Int9N.fromString("-123456789").shiftDecimalRight(Integer.MAX_VALUE));
+        checkStringRepresentation("0", Int9N.fromString("0").shiftDecimalLeft(Integer.MAX_VALUE));
+        try {
+            Int9N.fromString("1").shiftDecimalRight(-1);
+            Assert.fail("Expecting IllegalArgumentException");
+        } catch (IllegalArgumentException e) {
+            System.out.println(e);
+        }
+        checkStringRepresentation("-1", Int9N.fromString("-1").shiftDecimalLeft(Integer.MAX_VALUE).shiftDecimalRight(Integer.MAX_VALUE));
+        try {
+            var x = Int9N.fromString("1");
+            for (int i = 0; i < 10; i++) {
+                x.shiftDecimalLeft(Integer.MAX_VALUE);
+            }
+            Assert.fail("Expecting ArithmeticException");
+        } catch (ArithmeticException e) {
+            System.out.println(e);
+        }
+    }
+
     @Test
     public void rightPartRegression() {
         var x = Int9N.fromScientific("1E30");
@@ -1343,6 +1470,40 @@ public void fromLong() {
         checkFromLong(Long.MIN_VALUE);
     }
 
+    @Test
+    public void binaryConversion() {
+        var rnd = new Random();
+        String[] values = { "0", "1", "-1", "255", "-256", "4294967295", "-4294967296", "18446744073709551616", "-1" + "0".repeat(900) };
+        for (String value : values) {
+            checkBinaryConversion(value);
+        }
+        for (int length : new int[] { 10, 300, 1_000, 20_000, 100_000 }) {
+            for (int i = 0; i < 5; i++) {
+                String sign = rnd.nextBoolean() ? "" : "-";
+                String suffix = rnd.nextBoolean() ? "" : "0".repeat(random(rnd, 1, 100));
+                checkBinaryConversion(sign + randomNumericString(rnd, 1, length) + suffix);
+            }
+        }
+        checkBinaryConversion(BigInteger.TWO.pow(100_000).toString());
+        checkBinaryConversion(BigInteger.TWO.pow(100_000).negate().toString());
+        checkBinaryConversion(BigInteger.TWO.pow(100_000).subtract(BigInteger.ONE).toString());
+        try {
+            Int9N.fromTwosComplement(new byte[0]);
+            Assert.fail("Expecting NumberFormatException");
+        } catch (NumberFormatException e) {
+            System.out.println(e);
+        }
+    }
+
+    private static void checkBinaryConversion(String value) {
+        var expected = new BigInteger(value);
+        var x = Int9N.fromString(value);
+        Assert.assertEquals(expected, x.toBigInteger());
+        Assert.assertArrayEquals(expected.toByteArray(), x.toTwosComplement());
+        checkStringRepresentation(expected.toString(), Int9N.fromBigInteger(expected));
+        checkStringRepresentation(expected.toString(), Int9N.fromTwosComplement(expected.toByteArray()));
+    }
+
     @Test
     public void halfInPlace() {
         checkHalf(false, "0", "0");
@@ -1636,6 +1797,7 @@ private void checkMulStrNew0(String lhsStr, String rhsStr) {
         Assert.assertEquals(expected, Int9N.multiplyKaratsuba(lhs, rhs, 1).toString());
         Assert.assertEquals(expected, Int9N.parallelMultiplyKaratsuba(lhs, rhs, pool()).toString());
         Assert.assertEquals(expected, Int9N.parallelMultiplyKaratsuba(lhs, rhs, 1, 2, pool()).toString());
+        Assert.assertEquals(expected, Int9N.parallelMultiplyKaratsuba(lhs, rhs, 1, 3, 99, pool()).toString());
 
         {
             var copy = lhs.copy();
@@ -1659,6 +1821,687 @@ public void mulStrHuge() {
         }
     }
 
+    /*
+     * 999_999_999 in every limb, the largest number of that length: its products have the largest
+     * column sums, cross products, carries and quotient estimates, so they test the kernels' overflow margins.
+     */
+    private static Int9N nines(int limbs) {
+        return Int9N.fromString("9".repeat(9 * limbs));
+    }
+
+    // nines(limbs) squared, i.e. 10^(18 * limbs) - 2 * 10^(9 * limbs) + 1
+    private static String ninesSquared(int limbs) {
+        return "9".repeat(9 * limbs - 1) + "8" + "0".repeat(9 * limbs - 1) + "1";
+    }
+
+    @Test
+    public void mulColumnsNative() {
+        boolean columnsDefault = Int9N.isColumnsMultiply();
+        try {
+            int[] lengths = { 1, 2, 9, 20, 150, 370, 1_000, 3_700, 10_000 };
+            for (boolean columns : new boolean[] { true, false }) {
+                Int9N.setColumnsMultiply(columns);
+                checkNative(lengths, BigInteger::multiply,
+                        Int9N::multiplySimple,
+                        (x, y) -> x.multiplyInPlace(y));
+                var nines = nines(400);
+                checkStringRepresentation(ninesSquared(400), Int9N.multiplySimple(nines, nines));
+            }
+        } finally {
+            Int9N.setColumnsMultiply(columnsDefault);
+        }
+    }
+
+    @Test
+    public void squareNative() {
+        var rnd = new Random();
+        int[] lengths = { 1, 9, 20, 370, 900, 2_500, 9_000, 30_000 };
+        for (int length : lengths) {
+            String suffix = rnd.nextBoolean() ? "" : "0".repeat(random(rnd, 1, 100));
+            String str = randomNumericString(rnd, length, length + 50) + suffix;
+            String expected = new BigInteger(str).pow(2).toString();
+            var x = Int9N.fromString(str);
+
+            checkStringRepresentation(expected, Int9N.multiplySimple(x, x));
+            checkStringRepresentation(expected, Int9N.multiplyKaratsuba(x, x, 3));
+            checkStringRepresentation(expected, Int9N.multiplyToomCook3(x, x, 2, 6));
+            checkStringRepresentation(expected, Int9N.parallelMultiplyKaratsuba(x, x, 3, 4, pool()));
+            checkStringRepresentation(expected, Int9N.multiplyNtt(x, x));
+            checkStringRepresentation(expected, x.multiply(x));
+            checkStringRepresentation(expected, Int9N.pow(x, 2));
+        }
+        for (int length : lengths) {
+            var nines = nines(length);
+            String expected = ninesSquared(length);
+            checkStringRepresentation(expected, Int9N.multiplySimple(nines, nines));
+            checkStringRepresentation(expected, Int9N.multiplyToomCook3(nines, nines, 2, 6));
+        }
+        String baseStr = randomNumericString(rnd, 50, 60);
+        var base = Int9N.fromString(baseStr);
+        String expected = new BigInteger(baseStr).pow(77).toString();
+        checkStringRepresentation(expected, Int9N.pow(base, 77));
+        checkStringRepresentation(expected, Int9N.parallelPow(base, 77, 3, 4, pool()));
+    }
+
+    @Test
+    public void mulKaratsubaNative() {
+        int[] lengths = { 20, 90, 370, 1_000, 9_000 };
+        for (int threshold : new int[] { 1, 2, 3, 4, 7, 40 }) {
+            checkNative(lengths, BigInteger::multiply,
+                    (x, y) -> Int9N.multiplyKaratsuba(x, y, threshold),
+                    (x, y) -> Int9N.multiplyKaratsuba(y, x, threshold));
+            var nines = nines(200);
+            checkStringRepresentation(ninesSquared(200), Int9N.multiplyKaratsuba(nines, nines, threshold));
+        }
+    }
+
+    @Test
+    public void mulToomCook3Native() {
+        int[] lengths = { 20, 90, 370, 1_000, 9_000, 30_000 };
+        for (int[] threshold : new int[][] { { 1, 1 }, { 1, 4 }, { 3, 9 }, { 7, 20 }, { 40, 240 } }) {
+            checkNative(lengths, BigInteger::multiply,
+                    (x, y) -> Int9N.multiplyToomCook3(x, y, threshold[0], threshold[1]),
+                    (x, y) -> Int9N.multiplyToomCook3(y, x, threshold[0], threshold[1]));
+            var nines = nines(2_000);
+            checkStringRepresentation(ninesSquared(2_000), Int9N.multiplyToomCook3(nines, nines, threshold[0], threshold[1]));
+        }
+
+        try {
+            Int9N.multiplyToomCook3(ONE, ONE, 0, 10);
+            Assert.fail("Expecting IllegalArgumentException");
+        } catch (IllegalArgumentException e) {
+            System.out.println(e);
+        }
+        try {
+            Int9N.multiplyToomCook3(ONE, ONE, 40, 39);
+            Assert.fail("Expecting IllegalArgumentException");
+        } catch (IllegalArgumentException e) {
+            System.out.println(e);
+        }
+    }
+
+    @Test
+    public void mulNttNative() {
+        int[] lengths = { 1, 9, 20, 370, 1_000, 9_000, 30_000, 100_000 };
+        checkNative(lengths, BigInteger::multiply,
+                Int9N::multiplyNtt,
+                (x, y) -> y.multiply(x));
+        var nines = nines(100_000);
+        checkStringRepresentation(ninesSquared(100_000), Int9N.multiplyNtt(nines, nines));
+        checkStringRepresentation("0", Int9N.multiplyNtt(nines, ZERO));
+    }
+
+    @Test
+    public void mulForeignNative() {
+        boolean columnsDefault = Int9N.isColumnsMultiply();
+        Int9N.setForeignMultiply(true);
+        try {
+            int[] lengths = { 1, 9, 20, 370, 3_000 };
+            for (boolean columns : new boolean[] { true, false }) {
+                Int9N.setColumnsMultiply(columns);
+                checkNative(lengths, BigInteger::multiply, Int9N::multiplySimple);
+            }
+        } finally {
+            Int9N.setForeignMultiply(false);
+            Int9N.setColumnsMultiply(columnsDefault);
+        }
+    }
+
+    // for the multiplication modes, which the kernel tests cover in more detail
+    private static final int[] MODE_LENGTHS = { 1, 400, 3_000, 30_000 };
+
+    /*
+     * Checks each of `fns` against `reference` for all pairs of operands of (about) `lengths` digits,
+     * and for each operand with itself, e.g. squares. See randomOperand().
+     */
+    @SafeVarargs
+    private static void checkNative(int[] lengths, BinaryOperator<BigInteger> reference, BinaryOperator<Int9N>... fns) {
+        var rnd = new Random();
+        for (int left : lengths) {
+            for (int right : lengths) {
+                String lhs = randomOperand(rnd, left);
+                String rhs = randomOperand(rnd, right);
+                String expected = reference.apply(new BigInteger(lhs), new BigInteger(rhs)).toString();
+                for (var fn : fns) {
+                    checkStringRepresentation(expected, fn.apply(Int9N.fromString(lhs), Int9N.fromString(rhs)));
+                }
+            }
+            String str = randomOperand(rnd, left);
+            String expected = reference.apply(new BigInteger(str), new BigInteger(str)).toString();
+            for (var fn : fns) {
+                var x = Int9N.fromString(str);
+                checkStringRepresentation(expected, fn.apply(x, x));
+            }
+        }
+    }
+
+    // length to length + 50 digits, negative or not, half of the time with trailing zero limbs
+    private static String randomOperand(Random rnd, int length) {
+        String sign = rnd.nextBoolean() ? "" : "-";
+        String suffix = rnd.nextBoolean() ? "" : "0".repeat(random(rnd, 1, 100));
+        return sign + randomNumericString(rnd, length, length + 50) + suffix;
+    }
+
+    @Test
+    public void mulOffHeapNative() {
+        Int9N.setOffHeapMultiply(true);
+        try {
+            checkNative(MODE_LENGTHS, BigInteger::multiply,
+                    Int9N::multiplyToomCook3,
+                    Int9N::multiplyNtt,
+                    (x, y) -> Int9N.parallelMultiplyKaratsuba(x, y, pool()));
+        } finally {
+            Int9N.setOffHeapMultiply(false);
+        }
+    }
+
+    @Test
+    public void mulParallelThresholdNative() {
+        var rnd = new Random();
+        for (int parallelThreshold : new int[] { 40, 100, 500 }) {
+            for (int i = 0; i < 10; i++) {
+                String lhs = randomNumericString(rnd, 1, 40_000) + (rnd.nextBoolean() ? "" : "0".repeat(random(rnd, 1, 100)));
+                String rhs = (rnd.nextBoolean() ? "" : "-") + randomNumericString(rnd, 1, 40_000);
+                String expected = new BigInteger(lhs).multiply(new BigInteger(rhs)).toString();
+                checkStringRepresentation(expected,
+                        Int9N.parallelMultiplyKaratsuba(Int9N.fromString(lhs), Int9N.fromString(rhs), 40, parallelThreshold, Integer.MAX_VALUE, pool()));
+            }
+        }
+        try {
+            Int9N.parallelMultiplyKaratsuba(Int9N.fromInt(1), Int9N.fromInt(2), 40, 39, 1, pool());
+            Assert.fail("Expecting IllegalArgumentException");
+        } catch (IllegalArgumentException e) {
+            System.out.println(e);
+        }
+    }
+
+    @Test
+    public void mulScratchArenaNative() {
+        Int9N.setScratchArena(true);
+        try {
+            checkNative(MODE_LENGTHS, BigInteger::multiply,
+                    Int9N::multiplyToomCook3,
+                    Int9N::multiplyNtt,
+                    (x, y) -> Int9N.parallelMultiplyKaratsuba(x, y, pool()),
+                    (x, y) -> Int9N.parallelMultiplyKaratsuba(x, y, 3, 4, pool()),
+                    (x, y) -> Int9N.parallelMultiplyKaratsuba(x, y, 1, 999, pool()));
+            checkNative(MODE_LENGTHS, BigInteger::divide, (x, y) -> Int9N.divide(x, y));
+        } finally {
+            Int9N.setScratchArena(false);
+        }
+    }
+
+    @Test
+    public void asciiNative() {
+        var rnd = new Random();
+        for (int length : new int[] { 280, 300, 1_000, 10_000, 100_000 }) {
+            for (int i = 0; i < 10; i++) {
+                String sign = rnd.nextBoolean() ? "" : rnd.nextBoolean() ? "-" : "+";
+                String zeroes = rnd.nextBoolean() ? "" : "0".repeat(random(rnd, 1, 20));
+                String suffix = rnd.nextBoolean() ? "" : "0".repeat(random(rnd, 1, 2_000));
+                String input = sign + zeroes + randomNumericString(rnd, length, length + 20) + suffix;
+                String expected = new BigInteger(input).toString();
+                checkString(expected, input);
+
+                // the digits within a bigger buffer
+                String padded = "x".repeat(i) + input + "y".repeat(random(rnd, 0, 20));
+                byte[] bytes = padded.getBytes(StandardCharsets.ISO_8859_1);
+                checkStringRepresentation(expected, Int9N.fromString(bytes, i, i + input.length()));
+                Assert.assertEquals(expected, Int9N.fromString(padded, i, i + input.length()).toString());
+
+                // a non-digit anywhere
+                int index = random(rnd, input.length() - length, input.length() - 1);
+                for (char c : new char[] { 'a', '/', ':', '\u00e9', '\u0130' }) {
+                    String invalid = input.substring(0, index) + c + input.substring(index + 1);
+                    try {
+                        Int9N.fromString(invalid);
+                        Assert.fail("Expecting NumberFormatException");
+                    } catch (NumberFormatException e) {
+                        Assert.assertEquals("Non-digit character '" + c + "' at index " + index, e.getMessage());
+                    }
+                    if (c <= 0xFF) {
+                        try {
+                            Int9N.fromString(invalid.getBytes(StandardCharsets.ISO_8859_1), 0, invalid.length());
+                            Assert.fail("Expecting NumberFormatException");
+                        } catch (NumberFormatException e) {
+                            Assert.assertEquals("Non-digit character '" + c + "' at index " + index, e.getMessage());
+                        }
+                    }
+                }
+            }
+        }
+        try {
+            Int9N.fromString(new byte[3], 2, 4);
+            Assert.fail("Expecting IndexOutOfBoundsException");
+        } catch (IndexOutOfBoundsException e) {
+            System.out.println(e);
+        }
+    }
+
+    @Test
+    public void mappedFileNative() throws IOException {
+        var rnd = new Random();
+        var file = Files.createTempFile(Int9NTest.class.getSimpleName(), ".txt");
+        try {
+            String[] values = {
+                    "0", "-1", "123456789", "-1000000000",
+                    randomNumericString(rnd, 100_000, 200_000),
+                    "-" + randomNumericString(rnd, 10_000, 20_000) + "0".repeat(100_000),
+            };
+            for (String value : values) {
+                var x = Int9N.fromString(value);
+                String expected = new BigInteger(value).toString();
+                try (var channel = FileChannel.open(file, StandardOpenOption.WRITE, StandardOpenOption.TRUNCATE_EXISTING)) {
+                    Assert.assertEquals(expected.length(), x.write(channel));
+                }
+                Assert.assertEquals(expected, Files.readString(file, StandardCharsets.ISO_8859_1));
+
+                try (var channel = FileChannel.open(file, StandardOpenOption.READ)) {
+                    var mapped = channel.map(FileChannel.MapMode.READ_ONLY, 0, channel.size());
+                    checkStringRepresentation(expected, Int9N.fromString(mapped, 0, mapped.limit()));
+                    int sign = x.isNegative() ? 1 : 0;
+                    checkStringRepresentation(expected.substring(sign), Int9N.fromString(mapped, sign, mapped.limit()));
+                    try (var arena = Arena.ofConfined()) {
+                        var segment = channel.map(FileChannel.MapMode.READ_ONLY, 0, channel.size(), arena);
+                        checkStringRepresentation(expected, Int9N.fromString(segment));
+                    }
+                }
+
+                var out = new ByteArrayOutputStream();
+                var sink = new ChunkedSink(AsciiDigitArraySink.of(out), random(rnd, 1, 10_000));
+                Assert.assertTrue(x.stream(sink));
+                Assert.assertTrue(sink.flush());
+                Assert.assertArrayEquals(x.toByteArray(/*includeSign*/ false), out.toByteArray());
+            }
+        } finally {
+            Files.delete(file);
+        }
+
+        var pipe = Pipe.open();
+        try (var sink = pipe.sink()) {
+            sink.configureBlocking(false);
+            Int9N.fromInt(1).write(sink);
+            Assert.fail("Expecting IllegalArgumentException");
+        } catch (IllegalArgumentException e) {
+            Assert.assertEquals("Non-blocking channel", e.getMessage());
+        } finally {
+            pipe.source().close();
+        }
+
+        var otherPipe = Pipe.open();
+        try (var sink = otherPipe.sink()) {
+            sink.configureBlocking(false);
+            AsciiDigitArraySink.of(sink);
+            Assert.fail("Expecting IllegalArgumentException");
+        } catch (IllegalArgumentException e) {
+            Assert.assertEquals("Non-blocking channel", e.getMessage());
+        } finally {
+            otherPipe.source().close();
+        }
+    }
+
+    @Test
+    public void binaryFormat() {
+        var rnd = new Random();
+        String[] values = {
+                "0", "-1", "999999999", "-1000000000", "5" + "0".repeat(30),
+                randomNumericString(rnd, 1, 10_000),
+                "-" + randomNumericString(rnd, 1_000, 2_000) + "0".repeat(10_000),
+        };
+        for (var buffer : new ByteBuffer[] { ByteBuffer.allocate(20_000), ByteBuffer.allocateDirect(20_000) }) {
+            for (String value : values) {
+                var x = Int9N.fromString(value);
+                buffer.clear().put((byte) 42);
+                x.writeTo(buffer);
+                x.negate().writeTo(buffer);
+                Assert.assertEquals(1 + 2 * x.binaryLength(), buffer.position());
+
+                buffer.flip().get();
+                var y = Int9N.readFrom(buffer);
+                Assert.assertEquals(x.toArrayString(), y.toArrayString());
+                checkStringRepresentation(new BigInteger(value).toString(), y);
+                checkStringRepresentation(x.negate().toString(), Int9N.readFrom(buffer));
+                Assert.assertFalse(buffer.hasRemaining());
+            }
+        }
+        var buffer = ByteBuffer.allocate(14);
+        Int9N.fromString("5" + "0".repeat(30)).writeTo(buffer);
+        Assert.assertEquals("Int9N {digits=31, negative=false, offset=0, length=4, capacity=1, data=[5000]}", Int9N.readFrom(buffer.flip()).toDebugString());
+
+        var x = Int9N.fromString("-123456789" + "0".repeat(27));
+        Assert.assertEquals(14, x.binaryLength());
+        buffer = ByteBuffer.allocate(14);
+        x.writeTo(buffer);
+        Assert.assertArrayEquals(new byte[] { 1, 1, 4, 0, 0, 0, 3, 0, 0, 0, 0x15, (byte) 0xCD, 0x5B, 0x07 }, buffer.array());
+
+        try {
+            x.writeTo(ByteBuffer.allocate(13));
+            Assert.fail();
+        } catch (BufferOverflowException e) {
+            // expected
+        }
+        try {
+            Int9N.readFrom(ByteBuffer.wrap(buffer.array(), 0, 13));
+            Assert.fail();
+        } catch (BufferUnderflowException e) {
+            // expected
+        }
+        checkBinaryFormatError("Unsupported binary format version: 2", 0, (byte) 2);
+        checkBinaryFormatError("Malformed binary header", 1, (byte) 2);
+        checkBinaryFormatError("Malformed binary header", 6, (byte) 4);
+        checkBinaryFormatError("Limb out of range: 1000000000", 10, (byte) 0x00, (byte) 0xCA, (byte) 0x9A, (byte) 0x3B);
+        checkBinaryFormatError("Limb out of range: 4294967295", 10, (byte) -1, (byte) -1, (byte) -1, (byte) -1);
+        checkBinaryFormatError("Leading zero limb", 10, (byte) 0, (byte) 0, (byte) 0, (byte) 0);
+    }
+
+    private static void checkBinaryFormatError(String message, int index, byte... bytes) {
+        var buffer = ByteBuffer.allocate(14);
+        Int9N.fromString("-123456789" + "0".repeat(27)).writeTo(buffer);
+        buffer.put(index, bytes).flip();
+        try {
+            Int9N.readFrom(buffer);
+            Assert.fail();
+        } catch (NumberFormatException e) {
+            Assert.assertEquals(message, e.getMessage());
+            Assert.assertEquals(0, buffer.position());
+        }
+    }
+
+    @Test
+    public void mulUnbalanced() {
+        var rnd = new Random();
+        int[][] lengths = { { 50, 50_000 }, { 450, 50_000 }, { 2_000, 30_000 }, { 1_000, 2_001 }, { 5_000, 9_999 } };
+        for (int[] length : lengths) {
+            String lhs = randomNumericString(rnd, length[0], length[0] + 9) + (rnd.nextBoolean() ? "" : "0".repeat(random(rnd, 1, 100)));
+            String rhs = "-" + randomNumericString(rnd, length[1], length[1] + 9);
+            String expected = new BigInteger(lhs).multiply(new BigInteger(rhs)).toString();
+            var x = Int9N.fromString(lhs);
+            var y = Int9N.fromString(rhs);
+
+            checkStringRepresentation(expected, Int9N.multiplyKaratsuba(x, y));
+            checkStringRepresentation(expected, Int9N.multiplyToomCook3(y, x));
+            checkStringRepresentation(expected, Int9N.multiplyToomCook3(x, y, 3, 5));
+            checkStringRepresentation(expected, Int9N.parallelMultiplyKaratsuba(x, y, pool()));
+            checkStringRepresentation(expected, Int9N.parallelMultiplyKaratsuba(y, x, 3, 40, 99, pool()));
+        }
+    }
+
+    @Test
+    public void tuning() {
+        var rnd = new Random();
+        String lhs = randomNumericString(rnd, 20_000, 30_000);
+        String rhs = "-" + randomNumericString(rnd, 5_000, 30_000);
+        var lhsInt = new BigInteger(lhs);
+        var rhsInt = new BigInteger(rhs);
+        var calibrated = Int9N.Tuning.calibrate(); // takes seconds, so only once
+        Assert.assertTrue(calibrated.toString(), calibrated.toomCook3Threshold >= calibrated.karatsubaThreshold);
+        Assert.assertTrue(calibrated.toString(), calibrated.parallelThreshold >= calibrated.karatsubaThreshold);
+        var previous = Int9N.getTuning();
+        try {
+            for (var tuning : new Int9N.Tuning[] { new Int9N.Tuning(3, 5, 7, 9, 2), new Int9N.Tuning(100, 100, 5_000, 1_000, 1), calibrated }) {
+                Int9N.setTuning(tuning);
+                Assert.assertSame(tuning, Int9N.getTuning());
+                var x = Int9N.fromString(lhs);
+                var y = Int9N.fromString(rhs);
+                String expected = lhsInt.multiply(rhsInt).toString();
+                checkStringRepresentation(expected, x.multiply(y));
+                checkStringRepresentation(expected, Int9N.multiplyKaratsuba(x, y));
+                checkStringRepresentation(expected, Int9N.parallelMultiplyKaratsuba(x, y, pool()));
+                checkStringRepresentation(expected, Int9N.parallelMultiplyNative(x, y, 3));
+                checkStringRepresentation(rhsInt.pow(3).toString(), Int9N.pow(y, 3));
+                var qr = Int9N.divideAndModulo(x, y.negate());
+                checkStringRepresentation(lhsInt.divide(rhsInt.negate()).toString(), qr[0]);
+                checkStringRepresentation(lhsInt.remainder(rhsInt.negate()).toString(), qr[1]);
+            }
+        } finally {
+            Int9N.setTuning(previous);
+        }
+
+        try {
+            new Int9N.Tuning(40, 39, 320, 500, 1);
+            Assert.fail();
+        } catch (IllegalArgumentException e) {
+            Assert.assertEquals("Illegal Toom-Cook-3 threshold: 39", e.getMessage());
+        }
+        try {
+            new Int9N.Tuning(40, 240, 320, 500, 0);
+            Assert.fail();
+        } catch (IllegalArgumentException e) {
+            Assert.assertEquals("Illegal max depth: 0", e.getMessage());
+        }
+    }
+
+    @Test
+    public void stats() throws JMException, InterruptedException {
+        var rnd = new Random();
+        var x = Int9N.fromString(randomNumericString(rnd, 9_000, 9_000));
+        var y = Int9N.fromString(randomNumericString(rnd, 9_000, 9_000));
+        var small = Int9N.fromString(randomNumericString(rnd, 900, 900));
+        var kinds = Int9N.Stats.Kind.values();
+        Int9N.setStats(true);
+        try {
+            var before = Int9N.Stats.snapshot();
+            Int9N.multiplySimple(small, small.negate());
+            Int9N.multiplyKaratsuba(x, y);
+            Int9N.multiplyNtt(x, y);
+            Int9N.parallelMultiplyKaratsuba(x, y, pool());
+            Int9N.parallelMultiplyNative(x, y, 2);
+            var after = Int9N.Stats.snapshot();
+            for (var kind : kinds) {
+                Assert.assertTrue(kind + " " + after, after.getCalls(kind) > before.getCalls(kind));
+                Assert.assertTrue(kind + " " + after, after.getNanos(kind) > before.getNanos(kind));
+            }
+            Assert.assertTrue(after.getNativeCalls() >= before.getNativeCalls() + 4);
+            // 100 + 100 limbs
+            Assert.assertTrue(after.getHistogram(Int9N.Stats.Kind.SCHOOLBOOK)[7] > before.getHistogram(Int9N.Stats.Kind.SCHOOLBOOK)[7]);
+            Assert.assertTrue(after.getScratchBytes() > before.getScratchBytes());
+            Assert.assertEquals(Int9N.Stats.BUCKETS, after.getHistogram(Int9N.Stats.Kind.NTT).length);
+
+            // threads terminated before the next snapshot are folded into the total, also when registering new ones
+            for (int i = 0; i < 200; i++) {
+                var thread = new Thread(() -> Int9N.multiplySimple(small, small));
+                thread.start();
+                thread.join();
+            }
+            Assert.assertTrue(Int9N.Stats.snapshot().getCalls(Int9N.Stats.Kind.SCHOOLBOOK) >= after.getCalls(Int9N.Stats.Kind.SCHOOLBOOK) + 200);
+
+            var server = ManagementFactory.getPlatformMBeanServer();
+            var name = new ObjectName(Int9N.Stats.OBJECT_NAME);
+            Assert.assertEquals(Boolean.TRUE, server.getAttribute(name, "Enabled"));
+            Assert.assertTrue((Long) server.getAttribute(name, "NativeCalls") >= after.getNativeCalls());
+            server.setAttribute(name, new Attribute("Enabled", false));
+            var disabled = Int9N.Stats.snapshot();
+            Int9N.multiplySimple(small, small);
+            Assert.assertEquals(disabled.getCalls(Int9N.Stats.Kind.SCHOOLBOOK), Int9N.Stats.snapshot().getCalls(Int9N.Stats.Kind.SCHOOLBOOK));
+        } finally {
+            Int9N.setStats(false);
+        }
+    }
+
+    @Test
+    public void multiplyWithPool() {
+        var rnd = new Random();
+        String lhs = randomNumericString(rnd, 9 * 400, 9 * 600); // above the NTT threshold
+        String rhs = "-" + randomNumericString(rnd, 9 * 400, 9 * 600);
+        String expected = new BigInteger(lhs).multiply(new BigInteger(rhs)).toString();
+        Int9N.setForkJoinPool(pool());
+        Int9N.setStats(true);
+        try {
+            long before = Int9N.Stats.snapshot().getCalls(Int9N.Stats.Kind.PARALLEL);
+            checkStringRepresentation(expected, Int9N.fromString(lhs).multiply(Int9N.fromString(rhs)));
+            Assert.assertEquals(before + 1, Int9N.Stats.snapshot().getCalls(Int9N.Stats.Kind.PARALLEL));
+        } finally {
+            Int9N.setStats(false);
+            Int9N.setForkJoinPool(null);
+        }
+    }
+
+    @Test
+    public void nativeLibVariants() {
+        var v2 = Set.of("cx16", "lahf_lm", "popcnt", "pni", "sse4_1", "sse4_2", "ssse3");
+        var v3 = new HashSet<>(v2);
+        v3.addAll(List.of("abm", "avx", "avx2", "bmi1", "bmi2", "f16c", "fma", "movbe", "xsave"));
+        var v4 = new HashSet<>(v3);
+        v4.addAll(List.of("avx512f", "avx512bw", "avx512cd", "avx512dq", "avx512vl"));
+        var avx512NoV3 = new HashSet<>(v2);
+        avx512NoV3.addAll(List.of("avx512f", "avx512bw", "avx512cd", "avx512dq", "avx512vl"));
+
+        Assert.assertEquals(List.of("int9.so"), Int9N.NativeLibLoader.variants("int9", "amd64", "Linux", Set.of()));
+        Assert.assertEquals(List.of("int9-x86-64-v2.so", "int9.so"), Int9N.NativeLibLoader.variants("int9", "amd64", "Linux", v2));
+        Assert.assertEquals(List.of("int9-x86-64-v2.so", "int9.so"), Int9N.NativeLibLoader.variants("int9", "amd64", "Linux", avx512NoV3));
+        Assert.assertEquals(List.of("int9-x86-64-v3.so", "int9-x86-64-v2.so", "int9.so"), Int9N.NativeLibLoader.variants("int9", "amd64", "Linux", v3));
+        Assert.assertEquals(List.of("int9-x86-64-v4.so", "int9-x86-64-v3.so", "int9-x86-64-v2.so", "int9.so"), Int9N.NativeLibLoader.variants("int9", "x86_64", "Linux", v4));
+        Assert.assertEquals(List.of("int9-x86-64-v3.dll", "int9-x86-64-v2.dll", "int9.dll"), Int9N.NativeLibLoader.variants("int9", "amd64", "Windows 11", v3));
+
+        Assert.assertEquals(List.of("int9-aarch64.so", "int9.so"), Int9N.NativeLibLoader.variants("int9", "aarch64", "Linux", Set.of("fp", "asimd")));
+        Assert.assertEquals(List.of("int9-aarch64-sve.so", "int9-aarch64.so", "int9.so"), Int9N.NativeLibLoader.variants("int9", "aarch64", "Linux", Set.of("fp", "asimd", "sve")));
+        Assert.assertEquals(List.of("int9-aarch64.dylib", "int9.dylib"), Int9N.NativeLibLoader.variants("int9", "aarch64", "Mac OS X", Set.of()));
+
+        Assert.assertEquals(List.of("int9.so"), Int9N.NativeLibLoader.variants("int9", "riscv64", "Linux", Set.of()));
+    }
+
+    @Test
+    public void mulParallelNative() {
+        checkNative(MODE_LENGTHS, BigInteger::multiply,
+                (x, y) -> Int9N.parallelMultiplyNative(x, y, 4),
+                (x, y) -> Int9N.parallelMultiplyNative(x, y, 8),
+                (x, y) -> Int9N.parallelMultiplyNative(x, y, 1, 1, 5),
+                (x, y) -> Int9N.parallelMultiplyNative(x, y, 3, 10, 1),
+                (x, y) -> Int9N.parallelMultiplyNative(x, y, 3, 10, 3),
+                (x, y) -> Int9N.parallelMultiplyNative(x, y, 3, 10, 16));
+        try {
+            Int9N.parallelMultiplyNative(Int9N.fromInt(1), Int9N.fromInt(2), 40, 40, 0);
+            Assert.fail("Expecting IllegalArgumentException");
+        } catch (IllegalArgumentException e) {
+            System.out.println(e);
+        }
+    }
+
+    @Test
+    public void divideNative() {
+        int[] lengths = { 1, 9, 10, 20, 370, 1_000, 9_000, 30_000 };
+        checkNative(lengths, BigInteger::divide,
+                (x, y) -> Int9N.divideAndModulo(x, y)[0],
+                (x, y) -> Int9N.divideAndModulo(x, y, /*newtonThreshold*/ 1)[0],
+                (x, y) -> x.divide(y));
+        checkNative(lengths, BigInteger::remainder,
+                (x, y) -> Int9N.divideAndModulo(x, y)[1],
+                (x, y) -> Int9N.divideAndModulo(x, y, /*newtonThreshold*/ 1)[1],
+                (x, y) -> x.modulo(y));
+        var nines = nines(3_000);
+        var square = Int9N.multiplyNtt(nines, nines);
+        checkStringRepresentation(nines.toString(), Int9N.divide(square, nines));
+        checkStringRepresentation("0", Int9N.modulo(square, nines));
+        checkStringRepresentation("1", Int9N.divide(nines, nines));
+        checkStringRepresentation("0", Int9N.divide(ONE, nines));
+
+        try {
+            Int9N.divide(nines, ZERO);
+            Assert.fail("Expecting ArithmeticException");
+        } catch (ArithmeticException e) {
+            System.out.println(e);
+        }
+        try {
+            Int9N.divideAndModulo(nines, ONE, 0);
+            Assert.fail("Expecting IllegalArgumentException");
+        } catch (IllegalArgumentException e) {
+            System.out.println(e);
+        }
+    }
+
+    @Test
+    public void moduloIntsNative() {
+        var rnd = new Random();
+        for (int i = 0; i < 1_000; i++) {
+            String sign = rnd.nextBoolean() ? "" : "-";
+            String suffix = rnd.nextBoolean() ? "" : "0".repeat(random(rnd, 1, 1_000));
+            String str = sign + randomNumericString(rnd, 1, 1_000) + suffix;
+            int[] divisors = new int[rnd.nextInt(20)];
+            for (int j = 0; j < divisors.length; j++) {
+                divisors[j] = switch (rnd.nextInt(4)) {
+                    case 0 -> Integer.MIN_VALUE;
+                    case 1 -> random(rnd, 1, 10) * (rnd.nextBoolean() ? 1 : -1);
+                    default -> rnd.nextInt(Integer.MAX_VALUE) + 1;
+                };
+            }
+            var x = Int9N.fromString(str);
+            int[] remainders = x.modulo(divisors);
+            for (int j = 0; j < divisors.length; j++) {
+                var expected = new BigInteger(str).remainder(BigInteger.valueOf(divisors[j]));
+                Assert.assertEquals(expected.intValueExact(), remainders[j]);
+                Assert.assertEquals(expected.intValueExact(), x.modulo(divisors[j]));
+            }
+        }
+        try {
+            Int9N.fromInt(10).modulo(new int[] { 3, 0 });
+            Assert.fail("Expecting ArithmeticException");
+        } catch (ArithmeticException e) {
+            System.out.println(e);
+        }
+    }
+
+    @Test
+    public void addSubtractNative() {
+        var rnd = new Random();
+        for (int i = 0; i < 1_000; i++) {
+            String lhsSign = rnd.nextBoolean() ? "" : "-";
+            String rhsSign = rnd.nextBoolean() ? "" : "-";
+            String lhsSuffix = rnd.nextBoolean() ? "" : "0".repeat(random(rnd, 1, 2_000));
+            String rhsSuffix = rnd.nextBoolean() ? "" : "0".repeat(random(rnd, 1, 2_000));
+            // long runs of nines make the carries run through whole blocks
+            String lhsDigits = rnd.nextBoolean() ? randomNumericString(rnd, 1, 5_000) : "9".repeat(random(rnd, 500, 5_000));
+            String rhsDigits = randomNumericString(rnd, 1, 5_000);
+            String lhsStr = lhsSign + lhsDigits + lhsSuffix;
+            String rhsStr = rhsSign + rhsDigits + rhsSuffix;
+            var lhs = new BigInteger(lhsStr);
+            var rhs = new BigInteger(rhsStr);
+
+            var sum = Int9N.fromString(lhsStr).addInPlace(Int9N.fromString(rhsStr));
+            Assert.assertEquals(lhs.add(rhs).toString(), sum.toString());
+            var difference = Int9N.fromString(lhsStr).subtractInPlace(Int9N.fromString(rhsStr));
+            Assert.assertEquals(lhs.subtract(rhs).toString(), difference.toString());
+
+            var x = Int9N.fromString(lhsStr);
+            Assert.assertEquals(lhs.shiftLeft(1).toString(), x.addInPlace(x).toString());
+            Assert.assertEquals("0", x.subtractInPlace(x).toString());
+        }
+    }
+
+    @Test
+    public void multiplyAddNative() {
+        var rnd = new Random();
+        for (int i = 0; i < 100; i++) {
+            var expected = BigInteger.ZERO;
+            var acc = Int9N.fromInt(0);
+            for (int j = 0; j < 20; j++) {
+                String lhsSign = rnd.nextInt(4) == 0 ? "-" : "";
+                String rhsSign = rnd.nextInt(4) == 0 ? "-" : "";
+                String lhsSuffix = rnd.nextBoolean() ? "" : "0".repeat(random(rnd, 1, 100));
+                String rhsSuffix = rnd.nextBoolean() ? "" : "0".repeat(random(rnd, 1, 100));
+                String lhsStr = lhsSign + randomNumericString(rnd, 1, 1_000) + lhsSuffix;
+                String rhsStr = rhsSign + randomNumericString(rnd, 1, rnd.nextBoolean() ? 300 : 1_000) + rhsSuffix;
+                var lhs = new BigInteger(lhsStr);
+                var rhs = new BigInteger(rhsStr);
+
+                expected = expected.add(lhs.multiply(rhs));
+                var result = acc.multiplyAddInPlace(Int9N.fromString(lhsStr), Int9N.fromString(rhsStr));
+                Assert.assertSame(acc, result);
+                Assert.assertEquals(expected.toString(), acc.toString());
+
+                int factor = switch (rnd.nextInt(4)) {
+                    case 0 -> Integer.MIN_VALUE;
+                    case 1 -> Integer.MAX_VALUE;
+                    case 2 -> random(rnd, 0, 10) * (rnd.nextBoolean() ? 1 : -1);
+                    default -> rnd.nextInt();
+                };
+                expected = expected.add(lhs.multiply(BigInteger.valueOf(factor)));
+                acc.multiplyAddInPlace(Int9N.fromString(lhsStr), factor);
+                Assert.assertEquals(expected.toString(), acc.toString());
+            }
+            Assert.assertEquals(expected.add(expected.multiply(expected)).toString(), acc.multiplyAddInPlace(acc, acc).toString());
+        }
+    }
+
     @Test
     public void randomHuge() {
         int[] lengths = { 10, 1234, 10_000 };
@@ -1727,6 +2570,201 @@ private static void checkPowStr(String expected, String baseStr, int exponent) {
         Assert.assertEquals(expected, Int9N.parallelPow(base, exponent, 1, 999, pool()).toString());
     }
 
+    @Test
+    public void powWindow() {
+        var rnd = new Random();
+        String[] bases = {
+                "2", "-3", "7", "999999999", "-1000000000", "1" + "0".repeat(50), "-1" + "0".repeat(9),
+                randomNumericString(rnd, 10, 20), randomNumericString(rnd, 100, 200) + "0".repeat(random(rnd, 1, 30)),
+        };
+        int[] exponents = { 1, 2, 3, 5, 16, 31, 100, 255, 1000, random(rnd, 1, 3000) };
+        for (String baseStr : bases) {
+            var base = Int9N.fromString(baseStr);
+            for (int exponent : exponents) {
+                String expected = new BigInteger(baseStr).pow(exponent).toString();
+                checkStringRepresentation(expected, Int9N.pow(base, exponent));
+                checkStringRepresentation(expected, Int9N.pow(base, exponent, random(rnd, 1, 100), random(rnd, 1, 8)));
+                checkStringRepresentation(expected, Int9N.parallelPow(base, exponent, pool()));
+            }
+            Assert.assertEquals(baseStr, base.toString()); // not modified
+        }
+        for (int exponent : new int[] { 100_000, 1_000_000 }) {
+            Assert.assertEquals(BigInteger.valueOf(7).pow(exponent), Int9N.pow(Int9N.fromInt(7), exponent).toBigInteger());
+        }
+        var x = Int9N.pow(Int9N.fromString("-7000000000"), 10_001);
+        Assert.assertEquals(9 * 10_001, x.length() - x.toString().replaceAll("0+$", "").length());
+        Assert.assertEquals(BigInteger.valueOf(-7).pow(10_001), Int9N.fromString(x.toString().replaceAll("0+$", "")).toBigInteger());
+        try {
+            Int9N.pow(Int9N.fromInt(2), 10, 40, 0);
+            Assert.fail();
+        } catch (IllegalArgumentException e) {
+            Assert.assertEquals("Illegal window size: 0", e.getMessage());
+        }
+    }
+
+    @Test
+    public void productTree() {
+        var rnd = new Random();
+        int[] ints = new int[3000];
+        var factorial = BigInteger.ONE;
+        for (int i = 0; i < ints.length; i++) {
+            ints[i] = i + 1;
+            factorial = factorial.multiply(BigInteger.valueOf(ints[i]));
+        }
+        var factors = new ArrayList<Int9N>();
+        var expected = BigInteger.ONE;
+        for (int i = 0; i < 200; i++) {
+            String factor = (rnd.nextInt(10) == 0 ? "-" : "") + randomNumericString(rnd, 1, rnd.nextBoolean() ? 20 : 2_000);
+            factors.add(Int9N.fromString(factor));
+            expected = expected.multiply(new BigInteger(factor));
+        }
+        try {
+            for (var pool : new ForkJoinPool[] { null, pool() }) {
+                Int9N.setForkJoinPool(pool);
+                Assert.assertEquals(factorial, Int9N.product(ints).toBigInteger());
+                Assert.assertEquals(expected, Int9N.product(factors).toBigInteger());
+                Assert.assertEquals(expected, Int9N.product(factors.toArray(new Int9N[0])).toBigInteger());
+
+                checkStringRepresentation("1", Int9N.product(new int[0]));
+                checkStringRepresentation("0", Int9N.product(new int[] { 5, 0, -7 }));
+                checkStringRepresentation("-35", Int9N.product(new int[] { 5, -7 }));
+                checkStringRepresentation("-1000000000", Int9N.product(Int9N.fromString("-1000000000")));
+            }
+        } finally {
+            Int9N.setForkJoinPool(null);
+        }
+        Assert.assertEquals(expected, factors.stream().map(Int9N::toBigInteger).reduce(BigInteger.ONE, BigInteger::multiply)); // not modified
+    }
+
+    @Test
+    public void modContext() {
+        var rnd = new Random();
+        String[] moduli = {
+                "1", "3", "7", "999999999", "1000000001", "1" + "0".repeat(50) + "1",
+                randomNumericString(rnd, 10, 20) + "3", randomNumericString(rnd, 300, 400) + "7", randomNumericString(rnd, 1_000, 2_000) + "9",
+        };
+        for (String modulusStr : moduli) {
+            var m = new BigInteger(modulusStr);
+            var context = new Int9N.ModContext(Int9N.fromString(modulusStr));
+            checkStringRepresentation(modulusStr, context.getModulus());
+            for (int i = 0; i < 20; i++) {
+                String lhs = (rnd.nextBoolean() ? "-" : "") + randomNumericString(rnd, 1, modulusStr.length() * (i % 5 == 0 ? 2 : 1));
+                String rhs = i % 4 == 0 ? m.subtract(BigInteger.ONE).toString() : randomNumericString(rnd, 1, modulusStr.length()) + "0".repeat(i % 3 * 9);
+                var a = Int9N.fromString(lhs);
+                var b = Int9N.fromString(rhs);
+                var x = new BigInteger(lhs);
+                var y = new BigInteger(rhs);
+                checkStringRepresentation(x.mod(m).toString(), context.mod(a));
+                checkStringRepresentation(x.multiply(y).mod(m).toString(), context.modMul(a, b));
+                checkStringRepresentation(x.multiply(x).mod(m).toString(), context.modSquare(a));
+                var e = new BigInteger(randomNumericString(rnd, 1, i < 10 ? 3 : 60));
+                checkStringRepresentation(y.modPow(e, m).toString(), context.modPow(b, Int9N.fromBigInteger(e)));
+                checkStringRepresentation(x.modPow(e, m).toString(), context.modPow(a, Int9N.fromBigInteger(e), random(rnd, 1, 8)));
+                Assert.assertEquals(lhs, a.toString()); // not modified
+                Assert.assertEquals(rhs, b.toString());
+            }
+
+            // a chain of products in Montgomery form, in place
+            var x = new BigInteger(randomNumericString(rnd, 1, modulusStr.length()));
+            var y = new BigInteger("-" + randomNumericString(rnd, 1, modulusStr.length() * 2));
+            var acc = context.toMontgomery(Int9N.fromBigInteger(x));
+            var factor = context.toMontgomery(Int9N.fromBigInteger(y));
+            var expected = x.mod(m);
+            for (int i = 0; i < 50; i++) {
+                if (i % 3 == 0) {
+                    context.modSquareInPlace(acc, acc);
+                    expected = expected.multiply(expected).mod(m);
+                } else {
+                    context.modMulInPlace(acc, factor, acc);
+                    expected = expected.multiply(y).mod(m);
+                }
+            }
+            var copy = acc.copy();
+            context.modMulInPlace(acc, acc, factor);
+            checkStringRepresentation(expected.toString(), context.fromMontgomery(copy));
+            checkStringRepresentation(expected.multiply(y).mod(m).toString(), context.fromMontgomery(acc));
+            checkStringRepresentation(y.mod(m).toString(), context.fromMontgomery(factor));
+
+            checkStringRepresentation(BigInteger.ONE.mod(m).toString(), context.modPow(Int9N.fromInt(5), 0));
+            checkStringRepresentation(BigInteger.TWO.modPow(BigInteger.valueOf(Integer.MAX_VALUE), m).toString(), context.modPow(Int9N.fromInt(2), Integer.MAX_VALUE));
+        }
+
+        // Fermat: a^(p - 1) = 1 mod p
+        var p = Int9N.fromString("170141183460469231731687303715884105727"); // 2^127 - 1
+        checkStringRepresentation("1", new Int9N.ModContext(p).modPow(Int9N.fromInt(3), p.subtract(Int9N.fromInt(1))));
+
+        for (String modulusStr : new String[] { "0", "-7", "2", "10", "15", "1" + "0".repeat(20) }) {
+            try {
+                new Int9N.ModContext(Int9N.fromString(modulusStr));
+                Assert.fail();
+            } catch (IllegalArgumentException e) {
+                Assert.assertEquals("Illegal modulus: must be positive and coprime to 10", e.getMessage());
+            }
+        }
+        var context = new Int9N.ModContext(Int9N.fromInt(7));
+        try {
+            context.modPow(Int9N.fromInt(2), -1);
+            Assert.fail();
+        } catch (ArithmeticException e) {
+            Assert.assertEquals("Negative exponent", e.getMessage());
+        }
+        try {
+            context.modPow(Int9N.fromInt(2), Int9N.fromInt(10), 9);
+            Assert.fail();
+        } catch (IllegalArgumentException e) {
+            Assert.assertEquals("Illegal window size: 9", e.getMessage());
+        }
+        var residue = new Int9N.ModContext(Int9N.fromInt(7)).toMontgomery(Int9N.fromInt(3));
+        try {
+            context.modSquareInPlace(residue, residue);
+            Assert.fail();
+        } catch (IllegalArgumentException e) {
+            Assert.assertEquals("Residue of another ModContext", e.getMessage());
+        }
+    }
+
+    @Test
+    public void accumulator() {
+        var rnd = new Random();
+        var numbers = new ArrayList<Int9N>();
+        var expected = BigInteger.ZERO;
+        var accumulator = new Int9N.Accumulator();
+        for (int i = 0; i < 10_000; i++) {
+            String str = (rnd.nextInt(3) == 0 ? "-" : "") + randomNumericString(rnd, 1, rnd.nextInt(100) == 0 ? 500 : 30)
+                    + (rnd.nextInt(10) == 0 ? "0".repeat(random(rnd, 1, 50)) : "");
+            var x = Int9N.fromString(str);
+            numbers.add(x);
+            expected = expected.add(new BigInteger(str));
+            accumulator.add(x);
+            if (i % 1_000 == 0) {
+                Assert.assertEquals(expected, accumulator.sum().toBigInteger());
+            }
+        }
+        Assert.assertEquals(expected, accumulator.sum().toBigInteger());
+        Assert.assertEquals(expected, numbers.stream().collect(Int9N.summing()).toBigInteger());
+        Assert.assertEquals(expected, numbers.parallelStream().collect(Int9N.summing()).toBigInteger());
+        Assert.assertEquals(expected, numbers.stream().map(Int9N::toBigInteger).reduce(BigInteger.ZERO, BigInteger::add)); // not modified
+
+        for (var x : numbers) {
+            accumulator.subtract(x);
+        }
+        checkStringRepresentation("0", accumulator.sum());
+        accumulator.add(Long.MIN_VALUE).add(-1).subtract(Int9N.fromString("999999999999999999999"));
+        Assert.assertEquals(BigInteger.valueOf(Long.MIN_VALUE).subtract(new BigInteger("1000000000000000000000")), accumulator.sum().toBigInteger());
+        accumulator.addAll(accumulator);
+        Assert.assertEquals(BigInteger.valueOf(Long.MIN_VALUE).subtract(new BigInteger("1000000000000000000000")).shiftLeft(1), accumulator.sum().toBigInteger());
+
+        var nines = new Int9N.Accumulator();
+        var nine = Int9N.fromString("9".repeat(90));
+        for (int i = 0; i < 1_000; i++) {
+            nines.add(nine);
+        }
+        nines.addAll(new Int9N.Accumulator().add(1_000));
+        checkStringRepresentation("1000" + "0".repeat(90), nines.sum());
+        checkStringRepresentation("0", new Int9N.Accumulator().sum());
+        checkStringRepresentation("0", Stream.<Int9N>empty().collect(Int9N.summing()));
+    }
+
     private void checkAddBig(String expected, String lhsStr, String rhsStr) {
         checkAddBig0(expected, lhsStr, rhsStr);
         checkAddBig0(expected, rhsStr, lhsStr);
@@ -89,6 +89,31 @@ private static void checkSealed(Int9...values) {
         }
     }
 
+    @Test
+    public void karatsubaThreshold() {
+        var rnd = new Random();
+        String lhs = randomNumericString(rnd, 2_000, 3_000);
+        String rhs = randomNumericString(rnd, 1_000, 3_000);
+        String expected = new BigInteger(lhs).multiply(new BigInteger(rhs)).toString();
+        int threshold = Int9.getKaratsubaThreshold();
+        try {
+            for (int t : new int[] { 1, 3, 1_000, Int9.calibrateKaratsubaThreshold() }) {
+                Int9.setKaratsubaThreshold(t);
+                Assert.assertEquals(t, Int9.getKaratsubaThreshold());
+                Assert.assertEquals(expected, Int9.fromString(lhs).multiply(Int9.fromString(rhs)).toString());
+                Assert.assertEquals(expected, Int9.multiplyKaratsuba(Int9.fromString(lhs), Int9.fromString(rhs)).toString());
+            }
+        } finally {
+            Int9.setKaratsubaThreshold(threshold);
+        }
+        try {
+            Int9.setKaratsubaThreshold(0);
+            Assert.fail();
+        } catch (IllegalArgumentException e) {
+            Assert.assertEquals("Illegal threshold: 0", e.getMessage());
+        }
+    }
+
     @Test
     public void copyFullSize() {
         {
@@ -1637,6 +1662,40 @@ public void fromLong() {
         checkFromLong(Long.MIN_VALUE);
     }
 
+    @Test
+    public void binaryConversion() {
+        var rnd = new Random();
+        String[] values = { "0", "1", "-1", "255", "-256", "4294967295", "-4294967296", "18446744073709551616", "-1" + "0".repeat(900) };
+        for (String value : values) {
+            checkBinaryConversion(value);
+        }
+        for (int length : new int[] { 10, 300, 1_000, 20_000, 100_000 }) {
+            for (int i = 0; i < 5; i++) {
+                String sign = rnd.nextBoolean() ? "" : "-";
+                String suffix = rnd.nextBoolean() ? "" : "0".repeat(random(rnd, 1, 100));
+                checkBinaryConversion(sign + randomNumericString(rnd, 1, length) + suffix);
+            }
+        }
+        checkBinaryConversion(BigInteger.TWO.pow(100_000).toString());
+        checkBinaryConversion(BigInteger.TWO.pow(100_000).negate().toString());
+        checkBinaryConversion(BigInteger.TWO.pow(100_000).subtract(BigInteger.ONE).toString());
+        try {
+            Int9.fromTwosComplement(new byte[0]);
+            Assert.fail("Expecting NumberFormatException");
+        } catch (NumberFormatException e) {
+            System.out.println(e);
+        }
+    }
+
+    private static void checkBinaryConversion(String value) {
+        var expected = new BigInteger(value);
+        var x = Int9.fromString(value);
+        Assert.assertEquals(expected, x.toBigInteger());
+        Assert.assertArrayEquals(expected.toByteArray(), x.toTwosComplement());
+        checkStringRepresentation(expected.toString(), Int9.fromBigInteger(expected));
+        checkStringRepresentation(expected.toString(), Int9.fromTwosComplement(expected.toByteArray()));
+    }
+
     @Test
     public void halfInPlace() {
         checkHalf(false, "0", "0");
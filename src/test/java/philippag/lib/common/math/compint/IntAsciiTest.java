@@ -57,6 +57,31 @@ private static ForkJoinPool pool() {
         return pool;
     }
 
+    @Test
+    public void karatsubaThreshold() {
+        var rnd = new Random();
+        String lhs = randomNumericString(rnd, 2_000, 3_000);
+        String rhs = randomNumericString(rnd, 1_000, 3_000);
+        String expected = new BigInteger(lhs).multiply(new BigInteger(rhs)).toString();
+        int threshold = IntAscii.getKaratsubaThreshold();
+        try {
+            for (int t : new int[] { 1, 3, 1_000, IntAscii.calibrateKaratsubaThreshold() }) {
+                IntAscii.setKaratsubaThreshold(t);
+                Assert.assertEquals(t, IntAscii.getKaratsubaThreshold());
+                Assert.assertEquals(expected, IntAscii.fromString(lhs).multiply(IntAscii.fromString(rhs)).toString());
+                Assert.assertEquals(expected, IntAscii.multiplyKaratsuba(IntAscii.fromString(lhs), IntAscii.fromString(rhs)).toString());
+            }
+        } finally {
+            IntAscii.setKaratsubaThreshold(threshold);
+        }
+        try {
+            IntAscii.setKaratsubaThreshold(0);
+            Assert.fail();
+        } catch (IllegalArgumentException e) {
+            Assert.assertEquals("Illegal threshold: 0", e.getMessage());
+        }
+    }
+
     @Test
     public void hash() {
         Assert.assertEquals('0', IntAscii.fromString("0").hashCode());